@@ -96,5 +96,233 @@ float cost_evaluator::operator()(expr * f, unsigned num_args, float const * args
     return eval(f);
 }
 
+cost_program::cost_program(ast_manager & m):
+    m(m),
+    m_util(m),
+    m_kind(NONE),
+    m_num_args(0),
+    m_var1(0),
+    m_var2(0),
+    m_num(0.0f),
+    m_depth(0) {
+}
+
+void cost_program::reset() {
+    m_kind = NONE;
+    m_code.reset();
+    m_stack.reset();
+    m_depth = 0;
+}
+
+bool cost_program::get_var(expr * e, unsigned & pos) const {
+    if (!is_var(e) || to_var(e)->get_idx() >= m_num_args)
+        return false;
+    pos = m_num_args - to_var(e)->get_idx() - 1;
+    return true;
+}
 
+void cost_program::emit(opcode op, unsigned arg, float num) {
+    m_code.push_back({ op, arg, num });
+    switch (op) {
+    case PUSH_NUM: 
+    case PUSH_VAR:
+        ++m_depth;
+        if (m_depth > m_stack.size())
+            m_stack.resize(m_depth);
+        break;
+    case NEG: 
+    case NOT:
+    case JUMP:
+        break;
+    default:
+        --m_depth;
+        break;
+    }
+}
+
+bool cost_program::compile_args(app * f, unsigned num_args) {
+    if (f->get_num_args() < num_args)
+        return false;
+    for (unsigned i = 0; i < num_args; ++i)
+        if (!compile_rec(f->get_arg(i)))
+            return false;
+    return true;
+}
+
+bool cost_program::compile_rec(expr * f) {
+    unsigned pos;
+    if (get_var(f, pos)) {
+        emit(PUSH_VAR, pos);
+        return true;
+    }
+    if (!is_app(f))
+        return false;
+    app * a = to_app(f);
+    family_id fid = a->get_family_id();
+    if (fid == m.get_basic_family_id()) {
+        switch (a->get_decl_kind()) {
+        case OP_TRUE:  emit(PUSH_NUM, 0, 1.0f); return true;
+        case OP_FALSE: emit(PUSH_NUM, 0, 0.0f); return true;
+        case OP_NOT:   
+            if (!compile_args(a, 1)) return false;
+            emit(NOT); 
+            return true;
+        case OP_EQ:    
+            if (!compile_args(a, 2)) return false;
+            emit(EQ); 
+            return true;
+        case OP_XOR:   
+            if (!compile_args(a, 2)) return false;
+            emit(XOR); 
+            return true;
+        case OP_AND: 
+        case OP_OR: {
+            // evaluate arguments until the first that decides the result.
+            bool is_and = a->get_decl_kind() == OP_AND;
+            unsigned_vector exits;
+            for (expr * arg : *a) {
+                if (!compile_rec(arg)) return false;
+                exits.push_back(m_code.size());
+                emit(is_and ? JUMP_IF_ZERO : JUMP_IF_NOT_ZERO);
+            }
+            emit(PUSH_NUM, 0, is_and ? 1.0f : 0.0f);
+            unsigned end = m_code.size();
+            emit(JUMP);
+            for (unsigned pc : exits)
+                patch(pc);
+            --m_depth;
+            emit(PUSH_NUM, 0, is_and ? 0.0f : 1.0f);
+            patch(end);
+            return true;
+        }
+        case OP_IMPLIES: {
+            if (!compile_args(a, 1)) return false;
+            unsigned t1 = m_code.size();
+            emit(JUMP_IF_ZERO);
+            if (!compile_rec(a->get_arg(1))) return false;
+            unsigned t2 = m_code.size();
+            emit(JUMP_IF_NOT_ZERO);
+            emit(PUSH_NUM, 0, 0.0f);
+            unsigned end = m_code.size();
+            emit(JUMP);
+            patch(t1);
+            patch(t2);
+            --m_depth;
+            emit(PUSH_NUM, 0, 1.0f);
+            patch(end);
+            return true;
+        }
+        case OP_ITE: {
+            if (!compile_args(a, 1)) return false;
+            unsigned else_pc = m_code.size();
+            emit(JUMP_IF_ZERO);
+            if (!compile_rec(a->get_arg(1))) return false;
+            unsigned end = m_code.size();
+            emit(JUMP);
+            patch(else_pc);
+            --m_depth;
+            if (!compile_rec(a->get_arg(2))) return false;
+            patch(end);
+            return true;
+        }
+        default:
+            return false;
+        }
+    }
+    if (fid == m_util.get_family_id()) {
+        opcode op;
+        switch (a->get_decl_kind()) {
+        case OP_NUM: {
+            rational r = a->get_decl()->get_parameter(0).get_rational();
+            emit(PUSH_NUM, 0, static_cast<float>(numerator(r).get_int64())/static_cast<float>(denominator(r).get_int64()));
+            return true;
+        }
+        case OP_UMINUS:
+            if (!compile_args(a, 1)) return false;
+            emit(NEG);
+            return true;
+        case OP_LE:  op = LE; break;
+        case OP_GE:  op = GE; break;
+        case OP_LT:  op = LT; break;
+        case OP_GT:  op = GT; break;
+        case OP_ADD: op = ADD; break;
+        case OP_SUB: op = SUB; break;
+        case OP_MUL: op = MUL; break;
+        case OP_DIV: op = DIV; break;
+        default:
+            return false;
+        }
+        if (!compile_args(a, 2)) return false;
+        emit(op);
+        return true;
+    }
+    return false;
+}
+
+bool cost_program::compile(expr * f, unsigned num_args) {
+    reset();
+    m_num_args = num_args;
+    unsigned pos1, pos2;
+    rational r;
+    if (get_var(f, pos1)) {
+        m_kind = VAR;
+        m_var1 = pos1;
+    }
+    else if (m_util.is_numeral(f, r)) {
+        m_kind = NUM;
+        m_num  = static_cast<float>(numerator(r).get_int64())/static_cast<float>(denominator(r).get_int64());
+    }
+    else if (m_util.is_add(f) && to_app(f)->get_num_args() == 2 &&
+             get_var(to_app(f)->get_arg(0), pos1) && get_var(to_app(f)->get_arg(1), pos2)) {
+        m_kind = ADD_VARS;
+        m_var1 = pos1;
+        m_var2 = pos2;
+    }
+    else if (compile_rec(f)) {
+        SASSERT(m_depth == 1);
+        m_kind = PROGRAM;
+    }
+    else 
+        reset();
+    return compiled();
+}
+
+float cost_program::run(float const * args) {
+#define BIN(OP) --sp; sp[-1] = OP; break
+    float * sp = m_stack.data();
+    unsigned pc = 0, sz = m_code.size();
+    while (pc < sz) {
+        instr const & i = m_code[pc++];
+        switch (i.m_op) {
+        case PUSH_NUM: *sp++ = i.m_num; break;
+        case PUSH_VAR: *sp++ = args[i.m_arg]; break;
+        case ADD: BIN(sp[-1] + sp[0]);
+        case SUB: BIN(sp[-1] - sp[0]);
+        case MUL: BIN(sp[-1] * sp[0]);
+        case DIV: 
+            if (sp[-1] == 0.0f) {
+                warning_msg("cost function division by zero");
+                BIN(1.0f);
+            }
+            BIN(sp[-1] / sp[0]);
+        case NEG: sp[-1] = -sp[-1]; break;
+        case NOT: sp[-1] = sp[-1] == 0.0f ? 1.0f : 0.0f; break;
+        case EQ:  BIN(sp[-1] == sp[0] ? 1.0f : 0.0f);
+        case XOR: BIN(sp[-1] != sp[0] ? 1.0f : 0.0f);
+        case LE:  BIN(sp[-1] <= sp[0] ? 1.0f : 0.0f);
+        case GE:  BIN(sp[-1] >= sp[0] ? 1.0f : 0.0f);
+        case LT:  BIN(sp[-1] <  sp[0] ? 1.0f : 0.0f);
+        case GT:  BIN(sp[-1] >  sp[0] ? 1.0f : 0.0f);
+        case JUMP: pc = i.m_arg; break;
+        case JUMP_IF_ZERO: 
+            if (*--sp == 0.0f) pc = i.m_arg; 
+            break;
+        case JUMP_IF_NOT_ZERO: 
+            if (*--sp != 0.0f) pc = i.m_arg; 
+            break;
+        }
+    }
+#undef BIN
+    return m_stack[0];
+}
 
@@ -7,7 +7,8 @@ Module Name:
 
 Abstract:
 
-    Simple evaluator for cost function
+    Simple evaluator for cost function, and a compiled form
+    of cost functions for functions evaluated many times.
 
 Author:
 
@@ -38,4 +39,58 @@ public:
     float operator()(expr * f, unsigned num_args, float const * args);
 };
 
+/**
+   \brief Cost function compiled into a flat sequence of instructions over a value stack.
+   Boolean connectives and ite are compiled into jumps, so that sub-expressions are
+   evaluated exactly when cost_evaluator evaluates them.
 
+   compile fails for expressions cost_evaluator reports as errors; clients then
+   continue to use cost_evaluator. Constants, variables and sums of two variables, 
+   such as the default (+ weight generation), are evaluated without the stack.
+*/
+class cost_program {
+    enum opcode {
+        PUSH_NUM, PUSH_VAR, ADD, SUB, MUL, DIV, NEG, NOT,
+        EQ, XOR, LE, GE, LT, GT, JUMP, JUMP_IF_ZERO, JUMP_IF_NOT_ZERO
+    };
+    struct instr {
+        opcode   m_op;
+        unsigned m_arg;  // variable position or jump target
+        float    m_num;
+    };
+    enum kind { NONE, NUM, VAR, ADD_VARS, PROGRAM };
+
+    ast_manager &   m;
+    arith_util      m_util;
+    kind            m_kind;
+    unsigned        m_num_args;
+    unsigned        m_var1, m_var2;
+    float           m_num;
+    svector<instr>  m_code;
+    svector<float>  m_stack;
+    unsigned        m_depth;
+
+    bool get_var(expr * e, unsigned & pos) const;
+    void emit(opcode op, unsigned arg = 0, float num = 0.0f);
+    void patch(unsigned pc) { m_code[pc].m_arg = m_code.size(); }
+    bool compile_rec(expr * f);
+    bool compile_args(app * f, unsigned num_args);
+    float run(float const * args);
+public:
+    cost_program(ast_manager & m);
+    /**
+       Compile f for argument arrays of size num_args, using the convention of cost_evaluator.
+       Return false if f contains expressions that cannot be evaluated.
+    */
+    bool compile(expr * f, unsigned num_args);
+    bool compiled() const { return m_kind != NONE; }
+    void reset();
+    float operator()(float const * args) {
+        switch (m_kind) {
+        case NUM:       return m_num;
+        case VAR:       return args[m_var1];
+        case ADD_VARS:  return args[m_var1] + args[m_var2];
+        default:        return run(args);
+        }
+    }
+};
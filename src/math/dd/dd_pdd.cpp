@@ -1150,13 +1150,15 @@ namespace dd {
         std::sort(m_free_nodes.begin(), m_free_nodes.end());
         m_free_nodes.reverse();
 
+        // keep pending entries and entries whose arguments and result survive
         ptr_vector<op_entry> to_delete, to_keep;
         for (auto* e : m_op_cache) {            
-            if (e->m_result != null_pdd) {
-                to_delete.push_back(e);
+            if (e->m_result == null_pdd || 
+                (reachable[e->m_pdd1] && reachable[e->m_pdd2] && reachable[e->m_result])) {
+                to_keep.push_back(e);
             }
             else {
-                to_keep.push_back(e);
+                to_delete.push_back(e);
             }
         }
         m_op_cache.reset();
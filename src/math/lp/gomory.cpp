@@ -21,6 +21,8 @@
 #include "math/lp/int_solver.h"
 #include "math/lp/lar_solver.h"
 #include "math/lp/lp_utils.h"
+#include <algorithm>
+#include <cmath>
 
 #define SMALL_CUTS 1
 namespace lp {
@@ -408,8 +410,41 @@ int gomory::find_basic_var() {
     return result;
 }
     
-lia_move gomory::operator()() {
-    lra.move_non_basic_columns_to_bounds(true);
+/**
+   \brief Collect at most max_num basic columns whose rows are Gomory cut targets,
+   preferring short rows.
+*/
+void gomory::find_basic_vars(unsigned max_num, unsigned_vector& result) {
+    svector<std::pair<unsigned, unsigned>> targets;
+    for (unsigned j : lra.r_basis()) {
+        if (!lia.column_is_int_inf(j))
+            continue;
+        const row_strip<mpq>& row = lra.get_row(lia.row_of_basic_column(j));
+        if (is_gomory_cut_target(row)) 
+            targets.push_back(std::make_pair(row.size(), j));
+    }
+    std::sort(targets.begin(), targets.end());
+    for (unsigned i = 0; i < targets.size() && i < max_num; ++i)
+        result.push_back(targets[i].second);
+}
+
+/**
+   \brief Distance of the current solution from the hyperplane of the cut m_t >= m_k.
+*/
+double gomory::efficacy() const {
+    mpq v(0);
+    double norm = 0;
+    for (lar_term::ival p : lia.m_t) {
+        v += p.coeff() * lia.get_value(p.column().index()).x;
+        double c = p.coeff().get_double();
+        norm += c * c;
+    }
+    if (norm == 0)
+        return 0;
+    return (lia.m_k - v).get_double() / sqrt(norm);
+}
+
+lia_move gomory::single_cut() {
     int j = find_basic_var();
     if (j == -1) return lia_move::undef;
     unsigned r = lia.row_of_basic_column(j);
@@ -420,6 +455,61 @@ lia_move gomory::operator()() {
     return cut(lia.m_t, lia.m_k, lia.m_ex, j, row);
 }
 
+/**
+   \brief Generate cuts from up to num_candidates rows and keep the one
+   with the largest efficacy.
+*/
+lia_move gomory::best_cut(unsigned num_candidates) {
+    unsigned_vector candidates;
+    find_basic_vars(num_candidates, candidates);
+    lar_term best_t;
+    mpq best_k;
+    explanation best_ex;
+    double best_efficacy = -1;
+    for (unsigned j : candidates) {
+        if (lia.settings().get_cancel_flag())
+            break;
+        lia.settings().stats().m_gomory_candidates++;
+        unsigned r = lia.row_of_basic_column(j);
+        SASSERT(lra.row_is_correct(r));
+        lia.m_ex->clear();
+        lia.m_upper = false;
+        lia_move mv = cut(lia.m_t, lia.m_k, lia.m_ex, j, lra.get_row(r));
+        if (mv == lia_move::conflict)
+            return mv;
+        if (mv != lia_move::cut)
+            continue;
+        double e = efficacy();
+        TRACE("gomory_cut", tout << "candidate j" << j << " efficacy: " << e << "\n";);
+        if (e > best_efficacy) {
+            best_efficacy = e;
+            best_t = lia.m_t;
+            best_k = lia.m_k;
+            best_ex = *lia.m_ex;
+        }
+    }
+    if (best_efficacy < 0) {
+        lia.m_t.clear();
+        lia.m_ex->clear();
+        return lia_move::undef;
+    }
+    lia.m_t = best_t;
+    lia.m_k = best_k;
+    *lia.m_ex = best_ex;
+    lia.m_upper = false;
+    return lia_move::cut;
+}
+
+lia_move gomory::operator()() {
+    lra.move_non_basic_columns_to_bounds(true);
+    lia.settings().stats().m_gomory_calls++;
+    unsigned num_candidates = lia.settings().gomory_candidates();
+    lia_move r = num_candidates <= 1 ? single_cut() : best_cut(num_candidates);
+    if (r == lia_move::cut)
+        lia.settings().stats().m_gomory_success++;
+    return r;
+}
+
 
 gomory::gomory(int_solver& lia): lia(lia), lra(lia.lra) { }
 
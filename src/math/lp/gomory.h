@@ -28,8 +28,12 @@ namespace lp {
         class int_solver& lia;
         class lar_solver& lra;
         int find_basic_var();
+        void find_basic_vars(unsigned max_num, unsigned_vector& result);
         bool is_gomory_cut_target(const row_strip<mpq>& row);
         lia_move cut(lar_term & t, mpq & k, explanation* ex, unsigned basic_inf_int_j, const row_strip<mpq>& row);
+        lia_move single_cut();
+        lia_move best_cut(unsigned num_candidates);
+        double efficacy() const;
     public:
         gomory(int_solver& lia);
         lia_move operator()();
@@ -111,6 +111,8 @@ public:
 
     void prefix_d();
 
+    void prefix_d(lp_primal_core_solver<double, double> & s);
+
     unsigned m_m() const { return m_r_A.row_count();  }
 
     unsigned m_n() const { return m_r_A.column_count(); }
@@ -128,6 +130,8 @@ public:
 
     void solve();
 
+    void find_feasible_basis_with_doubles();
+
     bool lower_bounds_are_set() const { return true; }
 
     const indexed_vector<mpq> & get_pivot_row() const {
@@ -273,7 +277,7 @@ public:
             case column_type::boxed:
                 if (x > m_r_solver.m_upper_bounds[j]) {
                     delta = m_r_solver.m_upper_bounds[j] - x;
-                    x += m_r_solver.m_upper_bounds[j];
+                    x = m_r_solver.m_upper_bounds[j];
                 } else {
                     delta = m_r_solver.m_lower_bounds[j] - x;
                     x = m_r_solver.m_lower_bounds[j];
@@ -11,6 +11,7 @@ Revision History:
 --*/
 #include <string>
 #include "util/vector.h"
+#include "util/util.h"
 #include "math/lp/lar_core_solver.h"
 #include "math/lp/lar_solution_signature.h"
 namespace lp {
@@ -76,21 +77,25 @@ void lar_core_solver::prefix_r() {
 }
 
 void lar_core_solver::prefix_d() {
-    m_d_solver.m_b.resize(m_d_solver.m_m());
-    m_d_solver.m_breakpoint_indices_queue.resize(m_d_solver.m_n());
-    m_d_solver.m_copy_of_xB.resize(m_d_solver.m_n());
-    m_d_solver.m_costs.resize(m_d_solver.m_n());
-    m_d_solver.m_d.resize(m_d_solver.m_n());
-    m_d_solver.m_ed.resize(m_d_solver.m_m());
-    m_d_solver.m_pivot_row.resize(m_d_solver.m_n());
-    m_d_solver.m_pivot_row_of_B_1.resize(m_d_solver.m_m());
-    m_d_solver.m_w.resize(m_d_solver.m_m());
-    m_d_solver.m_y.resize(m_d_solver.m_m());
-    m_d_solver.m_steepest_edge_coefficients.resize(m_d_solver.m_n());
-    m_d_solver.m_column_norms.clear();
-    m_d_solver.m_column_norms.resize(m_d_solver.m_n(), 2);
-    m_d_solver.clear_inf_set();
-    m_d_solver.resize_inf_set(m_d_solver.m_n());
+    prefix_d(m_d_solver);
+}
+
+void lar_core_solver::prefix_d(lp_primal_core_solver<double, double> & s) {
+    s.m_b.resize(s.m_m());
+    s.m_breakpoint_indices_queue.resize(s.m_n());
+    s.m_copy_of_xB.resize(s.m_n());
+    s.m_costs.resize(s.m_n());
+    s.m_d.resize(s.m_n());
+    s.m_ed.resize(s.m_m());
+    s.m_pivot_row.resize(s.m_n());
+    s.m_pivot_row_of_B_1.resize(s.m_m());
+    s.m_w.resize(s.m_m());
+    s.m_y.resize(s.m_m());
+    s.m_steepest_edge_coefficients.resize(s.m_n());
+    s.m_column_norms.clear();
+    s.m_column_norms.resize(s.m_n(), 2);
+    s.clear_inf_set();
+    s.resize_inf_set(s.m_n());
 }
 
 void lar_core_solver::fill_not_improvable_zero_sum_from_inf_row() {
@@ -172,8 +177,22 @@ void lar_core_solver::solve() {
             if (snapped)
                 m_r_solver.solve_Ax_eq_b();
         }
-        if (m_r_solver.m_look_for_feasible_solution_only) //todo : should it be set?
-            m_r_solver.find_feasible_solution();
+        if (m_r_solver.m_look_for_feasible_solution_only) { //todo : should it be set?
+            if (settings().float_simplex() && settings().use_tableau_rows() &&
+                m_r_solver.inf_set_size() >= settings().float_simplex_min_inf()) {
+                unsigned num_iterations = m_r_solver.total_iterations();
+                find_feasible_basis_with_doubles();
+                if (settings().get_cancel_flag()) {
+                    m_r_solver.set_status(lp_status::TIME_EXHAUSTED);
+                    return;
+                }
+                m_r_solver.find_feasible_solution();
+                if (m_r_solver.total_iterations() == num_iterations)
+                    ++settings().stats().m_float_simplex_hits;
+            }
+            else
+                m_r_solver.find_feasible_solution();
+        }
         else {
             m_r_solver.solve();
         }
@@ -193,5 +212,101 @@ void lar_core_solver::solve() {
 }
 
 
+/**
+   \brief Run the primal simplex in floating point on a copy of the rational
+   tableau, pivot the rational tableau to the basis found and move the non-basic
+   columns to the bounds they take in the floating point solution.
+   The floating point run is only a heuristic: the rational simplex that runs
+   afterwards repairs the remaining infeasibilities exactly, and pivots that are
+   singular in rationals are skipped.
+*/
+void lar_core_solver::find_feasible_basis_with_doubles() {
+    ++settings().stats().m_float_simplex_calls;
+    unsigned m = m_r_A.row_count(), n = m_r_A.column_count();
+    static_matrix<double, double> A(m, n);
+    create_double_matrix(A);
+    vector<double> x(n), lower(n), upper(n), b(m), costs(n);
+    double delta = find_delta_for_strict_boxed_bounds().get_double();
+    if (delta > 0.000001)
+        delta = 0.000001;
+    auto to_double = [&](numeric_pair<mpq> const & v) { return v.x.get_double() + delta * v.y.get_double(); };
+    for (unsigned j = 0; j < n; j++) {
+        if (lower_bound_is_set(j))
+            lower[j] = to_double(m_r_lower_bounds[j]);
+        if (upper_bound_is_set(j))
+            upper[j] = to_double(m_r_upper_bounds[j]);
+        x[j] = to_double(m_r_x[j]);
+    }
+    // recompute the basic columns, so that A*x = 0 holds in floating point
+    for (unsigned i = 0; i < m; i++) {
+        unsigned bj = m_r_basis[i];
+        double v = 0, a = 1;
+        for (auto const & c : A.m_rows[i]) {
+            if (c.var() == bj)
+                a = c.coeff();
+            else
+                v -= c.coeff() * x[c.var()];
+        }
+        x[bj] = v / a;
+    }
+    vector<unsigned> basis(m_r_basis), nbasis(m_r_nbasis);
+    vector<int> heading(m_r_heading);
+    lar_solution_signature signature;
+    {
+        // the floating point run uses the revised simplex with an LU factorization of the basis
+        flet<simplex_strategy_enum> _strategy(settings().simplex_strategy(), simplex_strategy_enum::lu);
+        lp_primal_core_solver<double, double> d_solver(A, b, x, basis, nbasis, heading, costs, m_column_types(), lower, upper, settings(), m_r_solver.m_column_names);
+        prefix_d(d_solver);
+        for (unsigned j = 0; j < n; j++)
+            if (!d_solver.column_is_feasible(j))
+                d_solver.insert_column_into_inf_set(j);
+        // floating point runs are not guaranteed to terminate
+        d_solver.m_iteration_limit = 10 * (m + n);
+        d_solver.find_feasible_solution();
+        // the reduced costs can drift away from the infeasibility costs, the run restarts from the basis reached
+        for (unsigned k = 0; k < 3 && d_solver.get_status() == lp_status::FLOATING_POINT_ERROR &&
+                 d_solver.m_factorization != nullptr && d_solver.m_factorization->get_status() == LU_status::OK &&
+                 !d_solver.A_mult_x_is_off() && !settings().get_cancel_flag(); ++k)
+            d_solver.find_feasible_solution();
+        settings().stats().m_float_simplex_iterations += d_solver.total_iterations();
+        TRACE("lar_solver", tout << "float simplex: " << d_solver.get_status() << " iterations: " << d_solver.total_iterations() << "\n";);
+        extract_signature_from_lp_core_solver(d_solver, signature);
+    }
+    if (settings().get_cancel_flag())
+        return;
+
+    // pivot the rational tableau to the floating point basis
+    for (unsigned j : basis) {
+        if (m_r_heading[j] >= 0)
+            continue;
+        // the leaving column is basic in a row of j and non-basic in the floating point basis
+        int row = -1;
+        unsigned row_size = UINT_MAX;
+        for (auto const & c : m_r_A.m_columns[j]) {
+            unsigned i = c.var();
+            if (heading[m_r_basis[i]] < 0 && m_r_A.m_rows[i].size() < row_size) {
+                row = i;
+                row_size = m_r_A.m_rows[i].size();
+            }
+        }
+        if (row == -1)
+            continue;
+        unsigned leaving = m_r_basis[row];
+        m_r_solver.change_basis_unconditionally(j, leaving);
+        if (!m_r_solver.pivot_column_tableau(j, row)) {
+            // unroll the last step
+            m_r_solver.change_basis_unconditionally(leaving, j);
+            VERIFY(m_r_solver.pivot_column_tableau(leaving, m_r_solver.m_basis_heading[leaving]));
+            break;
+        }
+        ++settings().stats().m_float_simplex_exact_pivots;
+        if (settings().get_cancel_flag())
+            return;
+    }
+    lp_assert(r_basis_is_OK());
+    // newly non-basic columns stay infeasible until they are moved to a bound
+    prepare_solver_x_with_signature_tableau(signature);
+    lp_assert(m_r_solver.non_basic_columns_are_set_correctly());
 }
 
+}
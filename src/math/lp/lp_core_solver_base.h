@@ -92,6 +92,7 @@ public:
     bool                  m_tracing_basis_changes;
     u_set*              m_pivoted_rows;
     bool                  m_look_for_feasible_solution_only;
+    unsigned              m_iteration_limit { UINT_MAX }; // bound on total_iterations(), used for floating point runs
 
     void start_tracing_basis_changes() {
         m_trace_of_basis_change_vector.resize(0);
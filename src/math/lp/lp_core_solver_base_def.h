@@ -431,6 +431,10 @@ time_is_over() {
         m_status = lp_status::TIME_EXHAUSTED;
         return true;
     }
+    else if (total_iterations() > m_iteration_limit) {
+        m_status = lp_status::ITERATIONS_EXHAUSTED;
+        return true;
+    }
     else {
         return false;
     }
@@ -33,4 +33,7 @@ void lp::lp_settings::updt_params(params_ref const& _p) {
     report_frequency = p.arith_rep_freq();
     m_simplex_strategy = static_cast<lp::simplex_strategy_enum>(p.arith_simplex_strategy());
     m_nlsat_delay = p.arith_nl_delay();
+    m_float_simplex = p.arith_float_simplex();
+    m_float_simplex_min_inf = p.arith_float_simplex_min_inf();
+    m_gomory_candidates = p.arith_gomory_candidates();
 }
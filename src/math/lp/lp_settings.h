@@ -119,13 +119,22 @@ struct statistics {
     unsigned m_patches_success;
     unsigned m_hnf_cutter_calls;
     unsigned m_hnf_cuts;
+    unsigned m_gomory_calls;
+    unsigned m_gomory_success;
+    unsigned m_gomory_candidates;
     unsigned m_nla_calls;
     unsigned m_horner_calls;
     unsigned m_horner_conflicts;
     unsigned m_cross_nested_forms;
     unsigned m_grobner_calls;
     unsigned m_grobner_conflicts;
+    unsigned m_grobner_eqs;
+    unsigned m_grobner_reused_eqs;
     unsigned m_cheap_eqs;
+    unsigned m_float_simplex_calls;
+    unsigned m_float_simplex_iterations;
+    unsigned m_float_simplex_exact_pivots;
+    unsigned m_float_simplex_hits;
     statistics() { reset(); }
     void reset() { memset(this, 0, sizeof(*this)); }
     void collect_statistics(::statistics& st) const {
@@ -141,12 +150,23 @@ struct statistics {
         st.update("arith-patches-success", m_patches_success);
         st.update("arith-hnf-calls", m_hnf_cutter_calls);
         st.update("arith-hnf-cuts", m_hnf_cuts);
+        st.update("arith-gomory-calls", m_gomory_calls);
+        st.update("arith-gomory-success", m_gomory_success);
+        st.update("arith-gomory-candidates", m_gomory_candidates);
         st.update("arith-horner-calls", m_horner_calls);
         st.update("arith-horner-conflicts", m_horner_conflicts);
         st.update("arith-horner-cross-nested-forms", m_cross_nested_forms);
         st.update("arith-grobner-calls", m_grobner_calls);
         st.update("arith-grobner-conflicts", m_grobner_conflicts);
+        st.update("arith-grobner-eqs", m_grobner_eqs);
+        st.update("arith-grobner-reused-eqs", m_grobner_reused_eqs);
+        if (m_grobner_eqs > 0)
+            st.update("arith-grobner-reuse-ratio", static_cast<double>(m_grobner_reused_eqs) / m_grobner_eqs);
         st.update("arith-cheap-eqs", m_cheap_eqs);
+        st.update("arith-float-simplex-calls", m_float_simplex_calls);
+        st.update("arith-float-simplex-iterations", m_float_simplex_iterations);
+        st.update("arith-float-simplex-exact-pivots", m_float_simplex_exact_pivots);
+        st.update("arith-float-simplex-hits", m_float_simplex_hits);
 
     }
 };
@@ -242,7 +262,17 @@ private:
     bool             m_enable_hnf { true };
     bool             m_print_external_var_name { false };
     bool             m_cheap_eqs { false };
+    bool             m_float_simplex { false };
+    unsigned         m_float_simplex_min_inf { 100 };
+    unsigned         m_gomory_candidates { 1 };
 public:
+    // number of rows a Gomory cut is generated from; the most efficacious cut is kept
+    unsigned gomory_candidates() const { return m_gomory_candidates; }
+    // search for a feasible basis in floating point before running the rational simplex
+    bool float_simplex() const { return m_float_simplex; }
+    bool& float_simplex() { return m_float_simplex; }
+    unsigned float_simplex_min_inf() const { return m_float_simplex_min_inf; }
+    unsigned& float_simplex_min_inf() { return m_float_simplex_min_inf; }
     bool print_external_var_name() const { return m_print_external_var_name; }
     bool cheap_eqs() const { return m_cheap_eqs;}
     unsigned hnf_cut_period() const { return m_hnf_cut_period; }
@@ -143,6 +143,7 @@ void core::add_monic(lpvar v, unsigned sz, lpvar const* vs) {
 void core::push() {
     TRACE("nla_solver_verbose", tout << "\n";);
     m_emons.push();
+    ++m_scope_lvl;
 }
 
      
@@ -150,6 +151,10 @@ void core::pop(unsigned n) {
     TRACE("nla_solver_verbose", tout << "n = " << n << "\n";);
     m_emons.pop(n);
     SASSERT(elists_are_consistent(false));
+    m_scope_lvl -= n;
+    // the saved basis may depend on rows and bounds that were just removed
+    if (m_scope_lvl < m_grobner_basis_lvl) 
+        reset_grobner_basis();
 }
 
 rational core::product_value(const monic& m) const {
@@ -1637,6 +1642,7 @@ void core::run_grobner() {
     lp_settings().stats().m_grobner_calls++;
     configure_grobner();
     m_pdd_grobner.saturate();
+    save_grobner_basis();
     bool conflict = false;
     unsigned n = m_pdd_grobner.number_of_conflicts_to_report();
     SASSERT(n > 0);
@@ -1661,13 +1667,45 @@ void core::run_grobner() {
 void core::configure_grobner() {
     m_pdd_grobner.reset();
     try {
-        set_level2var_for_grobner();
-        for (unsigned i : m_rows) {
-            add_row_to_grobner(m_lar_solver.A_r().m_rows[i]);
+        if (!m_nla_settings.grobner_reuse()) {
+            set_level2var_for_grobner();
+            for (unsigned i : m_rows) {
+                add_row_to_grobner(m_lar_solver.A_r().m_rows[i]);
+            }
+        }
+        else {
+            // The pdds of the previous run stay valid, and so does the order
+            // of the manager, until the basis is reset. Columns created since
+            // then are added by the manager on demand.
+            if (m_grobner_basis.empty()) {
+                reset_grobner_basis();
+                set_level2var_for_grobner();
+            }
+            vector<grobner_eq> inputs;
+            bool_vector reused;
+            for (unsigned i : m_rows) 
+                add_row_to_grobner_inputs(m_lar_solver.A_r().m_rows[i], inputs);
+            mark_reused_grobner_inputs(inputs, reused);
+            unsigned num_reused = 0;
+            for (auto const& e : m_grobner_basis) 
+                m_pdd_grobner.add(e.m_poly, mk_grobner_dep(e.m_cis));
+            for (unsigned i = 0; i < inputs.size(); ++i) {
+                if (reused[i]) 
+                    ++num_reused;
+                else 
+                    m_pdd_grobner.add(inputs[i].m_poly, inputs[i].m_dep);
+            }
+            lp_settings().stats().m_grobner_eqs += inputs.size();
+            lp_settings().stats().m_grobner_reused_eqs += num_reused;
+            TRACE("grobner", tout << "reused " << num_reused << " of " << inputs.size() << " equations\n";);
+            m_grobner_inputs.swap(inputs);
+            for (auto& e : m_grobner_inputs)
+                e.m_dep = nullptr;
         }
     }
     catch (...) {
         IF_VERBOSE(2, verbose_stream() << "pdd throw\n");
+        reset_grobner_basis();
         return;
     }
 #if 0
@@ -1822,6 +1860,80 @@ void core::add_row_to_grobner(const vector<lp::row_cell<rational>> & row) {
     m_pdd_grobner.add(sum, dep);    
 }
 
+void core::add_row_to_grobner_inputs(const vector<lp::row_cell<rational>> & row, vector<grobner_eq>& inputs) {
+    u_dependency *dep = nullptr;
+    dd::pdd sum = m_pdd_manager.mk_val(rational(0));
+    for (const auto &p : row) {
+        sum  += pdd_expr(p.coeff(), p.var(), dep);
+    }
+    if (sum.is_zero())
+        return;
+    inputs.push_back(grobner_eq(sum, dep));
+    unsigned_vector& cis = inputs.back().m_cis;
+    m_intervals.get_dep_intervals().linearize(dep, cis);
+    std::sort(cis.begin(), cis.end());
+    cis.shrink(static_cast<unsigned>(std::unique(cis.begin(), cis.end()) - cis.begin()));
+}
+
+/**
+   \brief Mark the equations of inputs that were also inputs of the previous run,
+   with the same polynomial and the same constraints. They are implied by the
+   basis of that run and need not be added again.
+*/
+void core::mark_reused_grobner_inputs(vector<grobner_eq> const& inputs, bool_vector& reused) {
+    reused.reset();
+    reused.resize(inputs.size(), false);
+    u_map<unsigned_vector> poly2inputs;
+    for (unsigned i = 0; i < inputs.size(); ++i) 
+        poly2inputs.insert_if_not_there(inputs[i].m_poly.index(), unsigned_vector()).push_back(i);
+    for (auto const& old_eq : m_grobner_inputs) {
+        auto* e = poly2inputs.find_core(old_eq.m_poly.index());
+        if (!e)
+            continue;
+        for (unsigned i : e->get_data().m_value) {
+            if (!reused[i] && inputs[i].m_cis == old_eq.m_cis) {
+                reused[i] = true;
+                break;
+            }
+        }
+    }
+}
+
+/**
+   \brief Keep the equations of the last run for the next one. The rows they are
+   derived from hold as long as the columns exist, and the bounds they use are
+   recorded in their constraints, so they remain valid until a scope below
+   the current one is popped.
+   The dependencies themselves are not kept: their leaves are allocated by
+   the interval dependency manager, which horner resets.
+*/
+void core::save_grobner_basis() {
+    if (!m_nla_settings.grobner_reuse())
+        return;
+    m_grobner_basis_lvl = m_scope_lvl;
+    m_grobner_basis.reset();
+    for (auto* e : m_pdd_grobner.equations()) {
+        m_grobner_basis.push_back(grobner_eq(e->poly(), nullptr));
+        unsigned_vector& cis = m_grobner_basis.back().m_cis;
+        m_pdd_grobner.dep().linearize(e->dep(), cis);
+        std::sort(cis.begin(), cis.end());
+        cis.shrink(static_cast<unsigned>(std::unique(cis.begin(), cis.end()) - cis.begin()));
+    }
+}
+
+u_dependency* core::mk_grobner_dep(unsigned_vector const& cis) {
+    u_dependency* dep = nullptr;
+    for (unsigned ci : cis)
+        dep = m_intervals.mk_join(dep, m_intervals.mk_leaf(ci));
+    return dep;
+}
+
+void core::reset_grobner_basis() {
+    m_grobner_inputs.reset();
+    m_grobner_basis.reset();
+    m_grobner_basis_lvl = 0;
+}
+
 
 void core::find_nl_cluster() {
     prepare_rows_and_active_vars();
@@ -171,6 +171,16 @@ public:
     dd::pdd_manager          m_pdd_manager;
     dd::solver               m_pdd_grobner;
 private:
+    struct grobner_eq {
+        dd::pdd         m_poly;
+        u_dependency*   m_dep;   // only valid while the equations are added
+        unsigned_vector m_cis;   // sorted constraints of the dependency
+        grobner_eq(dd::pdd const& p, u_dependency* d): m_poly(p), m_dep(d) {}
+    };
+    vector<grobner_eq>       m_grobner_inputs;  // input equations of the last Grobner run
+    vector<grobner_eq>       m_grobner_basis;   // equations produced by the last Grobner run
+    unsigned                 m_grobner_basis_lvl { 0 }; // scope level m_grobner_basis was computed at
+    unsigned                 m_scope_lvl { 0 };
     emonics                  m_emons;
     svector<lpvar>           m_add_buffer;
     mutable lp::u_set        m_active_var_set;
@@ -467,6 +477,11 @@ public:
     void set_active_vars_weights(nex_creator&);
     unsigned get_var_weight(lpvar) const;
     void add_row_to_grobner(const vector<lp::row_cell<rational>> & row);    
+    void add_row_to_grobner_inputs(const vector<lp::row_cell<rational>> & row, vector<grobner_eq>& inputs);
+    void mark_reused_grobner_inputs(vector<grobner_eq> const& inputs, bool_vector& reused);
+    void save_grobner_basis();
+    void reset_grobner_basis();
+    u_dependency* mk_grobner_dep(unsigned_vector const& cis);
     bool check_pdd_eq(const dd::solver::equation*);
     const rational& val_of_fixed_var_with_deps(lpvar j, u_dependency*& dep);
     dd::pdd pdd_expr(const rational& c, lpvar j, u_dependency*&);
@@ -29,6 +29,7 @@ class nla_settings {
     unsigned m_grobner_number_of_conflicts_to_report;
     unsigned m_grobner_quota;
     unsigned m_grobner_frequency;
+    bool     m_grobner_reuse;
     bool     m_run_nra;
     // expensive patching
     bool     m_expensive_patching;
@@ -44,6 +45,7 @@ public:
                      m_grobner_subs_fixed(false),
                      m_grobner_quota(0),
                      m_grobner_frequency(4),
+                     m_grobner_reuse(false),
                      m_run_nra(false),
                      m_expensive_patching(false)
     {}
@@ -72,6 +74,9 @@ public:
     bool& run_grobner() { return m_run_grobner; }
     unsigned grobner_frequency() const { return m_grobner_frequency; }
     unsigned& grobner_frequency() { return m_grobner_frequency; }
+    // keep the basis of the last run and start from it when its input equations are still present
+    bool grobner_reuse() const { return m_grobner_reuse; }
+    bool& grobner_reuse() { return m_grobner_reuse; }
 
     bool run_nra() const { return m_run_nra; }
     bool& run_nra() { return m_run_nra; }    
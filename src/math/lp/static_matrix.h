@@ -26,6 +26,8 @@ class row_cell {
 public:
     row_cell(unsigned j, unsigned offset, T const & val) : m_j(j), m_offset(offset), m_coeff(val) {
     }
+    row_cell(unsigned j, unsigned offset, T && val) : m_j(j), m_offset(offset), m_coeff(std::move(val)) {
+    }
     row_cell(unsigned j, unsigned offset) : m_j(j), m_offset(offset) {
     }
     inline const T & coeff() const { return m_coeff; }
@@ -129,6 +131,7 @@ public:
 
     void add_columns_at_the_end(unsigned delta);
     void add_new_element(unsigned i, unsigned j, const T & v);
+    void add_new_element(unsigned i, unsigned j, T && v);
 
     void add_row() {m_rows.push_back(row_strip<T>());}
     void add_column() {
@@ -141,6 +144,7 @@ public:
     void remove_last_column(unsigned j);
 
     void remove_element(vector<row_cell<T>> & row, row_cell<T> & elem_to_remove);
+    void remove_zeroes_in_row(unsigned i);
     
     void multiply_column(unsigned column, T const & alpha) {
         for (auto & t : m_columns[column]) {
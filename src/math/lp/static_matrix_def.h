@@ -61,8 +61,7 @@ template <typename T, typename X> bool static_matrix<T, X>::pivot_row_to_row_giv
         lp_assert(!is_zero(iv.coeff()));
         int j_offs = m_vector_of_row_offsets[j];
         if (j_offs == -1) { // it is a new element
-            T alv = alpha * iv.coeff();
-            add_new_element(ii, j, alv);
+            add_new_element(ii, j, alpha * iv.coeff());
         }
         else {
             addmul(rowii[j_offs].coeff(), iv.coeff(), alpha);
@@ -73,11 +72,7 @@ template <typename T, typename X> bool static_matrix<T, X>::pivot_row_to_row_giv
         m_vector_of_row_offsets[rowii[k].var()] = -1;
     }
 
-    // remove zeroes
-    for (unsigned k = rowii.size(); k-- > 0;  ) {
-        if (is_zero(rowii[k].coeff()))
-            remove_element(rowii, rowii[k]);
-    }
+    remove_zeroes_in_row(ii);
     return !rowii.empty();
 }
 
@@ -374,7 +369,7 @@ void static_matrix<T, X>::remove_element(vector<row_cell<T>> & row_vals, row_cel
     }
     
     if (row_offset != row_vals.size() - 1) {
-        auto & rc = row_vals[row_offset] = row_vals.back(); // copy from the tail
+        auto & rc = row_vals[row_offset] = std::move(row_vals.back()); // move from the tail
         m_columns[rc.var()][rc.offset()].offset() = row_offset;
     }
 
@@ -392,4 +387,47 @@ void static_matrix<T, X>::add_new_element(unsigned row, unsigned col, const T& v
     col_vals.push_back(column_cell(row, row_el_offs));
 }
 
+template <typename T, typename X>
+void static_matrix<T, X>::add_new_element(unsigned row, unsigned col, T&& val) {
+    auto & row_vals = m_rows[row];
+    auto & col_vals = m_columns[col];
+    unsigned row_el_offs = row_vals.size();
+    unsigned col_el_offs = col_vals.size();
+    row_vals.push_back(row_cell<T>(col, col_el_offs, std::move(val)));
+    col_vals.push_back(column_cell(row, row_el_offs));
+}
+
+/**
+   \brief Remove the cells with zero coefficients from row i in one pass.
+   The surviving cells keep their relative order and are moved, not copied,
+   so no coefficients are reallocated.
+*/
+template <typename T, typename X>
+void static_matrix<T, X>::remove_zeroes_in_row(unsigned i) {
+    auto & row_vals = m_rows[i];
+    unsigned sz = row_vals.size();
+    unsigned k = 0;
+    for (; k < sz && !is_zero(row_vals[k].coeff()); ++k)
+        ;
+    unsigned w = k;
+    for (; k < sz; ++k) {
+        auto & rc = row_vals[k];
+        if (is_zero(rc.coeff())) {
+            auto & column_vals = m_columns[rc.var()];
+            unsigned column_offset = rc.offset();
+            if (column_offset != column_vals.size() - 1) {
+                auto & cc = column_vals[column_offset] = column_vals.back();
+                m_rows[cc.var()][cc.offset()].offset() = column_offset;
+            }
+            column_vals.pop_back();
+        }
+        else {
+            auto & moved = row_vals[w] = std::move(rc);
+            m_columns[moved.var()][moved.offset()].offset() = w;
+            ++w;
+        }
+    }
+    row_vals.shrink(w);
+}
+
 }
@@ -21,6 +21,7 @@ Author:
 #include "opt/maxsmt.h"
 #include "opt/opt_lns.h"
 #include "sat/sat_params.hpp"
+#include "smt/params/smt_params_helper.hpp"
 #include <algorithm>
 
 namespace opt {
@@ -40,6 +41,9 @@ namespace opt {
         p.set_uint("max_conflicts", m_max_conflicts);    
         p.set_uint("simplify.delay", 1000000);
   //      p.set_bool("gc.burst", true);
+        // the phase of the best model is restored on the same solver, so the SMT solver
+        // does not need to capture its units and lemmas with the phase.
+        p.set_uint("phase_transfer.lemma_size", 0);
         s.updt_params(p);
     }
 
@@ -50,6 +54,8 @@ namespace opt {
         p.set_uint("max_conflicts", sp.max_conflicts());
         p.set_uint("simplify.delay", sp.simplify_delay());
         p.set_uint("gc.burst", sp.gc_burst());
+        smt_params_helper smtp(p);
+        p.set_uint("phase_transfer.lemma_size", smtp.phase_transfer_lemma_size());
     }
 
     unsigned lns::climb(model_ref& mdl) {
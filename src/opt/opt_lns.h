@@ -16,6 +16,10 @@ Abstract:
     The soft constraints are assumed sorted by weight, such that the highest 
     weight soft constraint is first, followed by soft constraints of lower weight.
 
+    The SMT solver (opt_solver) also saves and forces phases with get_phase and
+    set_phase, so the phase of the best model steers SMT searches as it does for
+    the SAT solver.
+
 Author:
 
     Nikolaj Bjorner (nbjorner) 2021-02-01
@@ -18,22 +18,40 @@ Revision History:
 --*/
 #include "opt/opt_context.h"
 #include "opt/opt_parse.h"
+#include "util/decimal_scan.h"
 
 
 class opt_stream_buffer {
-    std::istream & m_stream;
+    std::istream * m_stream;
+    char const *   m_curr;
+    char const *   m_end;
     int            m_val;
     unsigned       m_line;
+
+    int get() {
+        if (m_stream)
+            return m_stream->get();
+        return m_curr < m_end ? static_cast<unsigned char>(*m_curr++) : EOF;
+    }
 public:    
     opt_stream_buffer(std::istream & s):
-        m_stream(s),
+        m_stream(&s),
+        m_curr(nullptr),
+        m_end(nullptr),
+        m_line(0) {
+        m_val = get();
+    }
+    opt_stream_buffer(char const* begin, char const* end):
+        m_stream(nullptr),
+        m_curr(begin),
+        m_end(end),
         m_line(0) {
-        m_val = m_stream.get();
+        m_val = get();
     }
     int  operator *() const { return m_val;}
-    void operator ++() { m_val = m_stream.get(); }
+    void operator ++() { m_val = get(); }
     int ch() const { return m_val; }
-    void next() { m_val = m_stream.get(); }
+    void next() { m_val = get(); }
     bool eof() const { return ch() == EOF; }
     unsigned line() const { return m_line; }
     void skip_whitespace() {
@@ -62,6 +80,7 @@ public:
     bool parse_token(char const* token);
     int parse_int();
     unsigned parse_unsigned();
+    unsigned parse_digits();
 };
 
 
@@ -76,10 +95,14 @@ bool opt_stream_buffer::parse_token(char const* token) {
     return 0 == *t;
 }
 
-unsigned opt_stream_buffer::parse_unsigned() {
-    skip_space();
-    if (ch() == '\n') {
-        return UINT_MAX;
+// input in memory is decoded eight digits at a time.
+unsigned opt_stream_buffer::parse_digits() {
+    if (!m_stream && decimal_scan::is_digit(static_cast<char>(ch()))) {
+        char const* curr = m_curr - 1;
+        unsigned val = decimal_scan::scan(curr, m_end);
+        m_curr = curr;
+        next();
+        return val;
     }
     unsigned val = 0;
     while (ch() >= '0' && ch() <= '9') {
@@ -89,6 +112,14 @@ unsigned opt_stream_buffer::parse_unsigned() {
     return val;
 }
 
+unsigned opt_stream_buffer::parse_unsigned() {
+    skip_space();
+    if (ch() == '\n') {
+        return UINT_MAX;
+    }
+    return parse_digits();
+}
+
 int opt_stream_buffer::parse_int() {
     int     val = 0;
     bool    neg = false;
@@ -105,10 +136,7 @@ int opt_stream_buffer::parse_int() {
         std::cerr << "(error line " << line() << " \"unexpected char: " << ((char)ch()) << "\" )\n";
         exit(3);
     }        
-    while (ch() >= '0' && ch() <= '9') {
-        val = val*10 + (ch() - '0');
-        next();
-    }
+    val = static_cast<int>(parse_digits());
     return neg ? -val : val; 
 }
 
@@ -309,6 +337,18 @@ void parse_opb(opt::context& opt, std::istream& is, unsigned_vector& h) {
     opb.parse();
 }
 
+void parse_wcnf(opt::context& opt, char const* begin, char const* end, unsigned_vector& h) {
+    opt_stream_buffer _is(begin, end);
+    wcnf w(opt, _is, h);
+    w.parse();
+}
+
+void parse_opb(opt::context& opt, char const* begin, char const* end, unsigned_vector& h) {
+    opt_stream_buffer _is(begin, end);
+    opb opb(opt, _is, h);
+    opb.parse();
+}
+
 /**
  * \brief Parser for a modest subset of the CPLEX LP format.
  * Reference: http://eaton.math.rpi.edu/cplex90html/reffileformatscplex/reffileformatscplex5.html
@@ -890,3 +930,8 @@ void parse_lp(opt::context& opt, std::istream& is, unsigned_vector& h) {
     lp.parse();
 }
 
+void parse_lp(opt::context& opt, char const* begin, char const* end, unsigned_vector& h) {
+    opt_stream_buffer _is(begin, end);
+    lp_parse lp(opt, _is, h);
+    lp.parse();
+}
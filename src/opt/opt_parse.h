@@ -24,5 +24,10 @@ void parse_opb(opt::context& opt, std::istream& is, unsigned_vector& h);
 
 void parse_lp(opt::context& opt, std::istream& is, unsigned_vector& h);
 
+// parse input held in memory, such as a memory mapped file.
 
+void parse_wcnf(opt::context& opt, char const* begin, char const* end, unsigned_vector& h);
 
+void parse_opb(opt::context& opt, char const* begin, char const* end, unsigned_vector& h);
+
+void parse_lp(opt::context& opt, char const* begin, char const* end, unsigned_vector& h);
@@ -19,7 +19,13 @@ Revision History:
 #include "sat/dimacs.h"
 #undef max
 #undef min
+#include <sstream>
+#include "util/decimal_scan.h"
+#include "util/scoped_ptr_vector.h"
 #include "sat/sat_solver.h"
+#ifndef SINGLE_THREAD
+#include <thread>
+#endif
 
 template<typename Buffer>
 static bool is_whitespace(Buffer & in) {
@@ -142,6 +148,203 @@ bool parse_dimacs(std::istream & in, std::ostream& err, sat::solver & solver) {
     return parse_dimacs_core(_in, err, solver);
 }
 
+namespace dimacs {
+
+    /**
+       \brief scan literals from a DIMACS file held in memory.
+       Decimal digits are decoded eight at a time, see util/decimal_scan.h.
+    */
+    class memory_scanner {
+        char const* m_file;
+        char const* m_curr;
+        char const* m_end;
+
+        static bool is_whitespace(char c) { return (c >= 9 && c <= 13) || c == 32; }
+
+        void skip_line() {
+            while (m_curr < m_end && *m_curr != '\n')
+                ++m_curr;
+        }
+
+        unsigned line() const {
+            unsigned n = 0;
+            for (char const* p = m_file; p < m_curr; ++p)
+                n += *p == '\n';
+            return n;
+        }
+
+    public:
+        memory_scanner(char const* file, char const* begin, char const* end):
+            m_file(file), m_curr(begin), m_end(end) {}
+
+        /**
+           \brief read the next literal. Return false at the end of input.
+           Comment and problem lines are skipped.
+        */
+        bool next(int& lit, std::ostream& err) {
+            while (true) {
+                while (m_curr < m_end && is_whitespace(*m_curr))
+                    ++m_curr;
+                if (m_curr == m_end)
+                    return false;
+                if (*m_curr != 'c' && *m_curr != 'p')
+                    break;
+                skip_line();
+            }
+            bool neg = false;
+            if (*m_curr == '-' || *m_curr == '+') {
+                neg = *m_curr == '-';
+                ++m_curr;
+            }
+            if (m_curr == m_end || !decimal_scan::is_digit(*m_curr)) {
+                int c = m_curr == m_end ? EOF : static_cast<unsigned char>(*m_curr);
+                if (20 <= c && c < 128)
+                    err << "(error, \"unexpected char: " << ((char)c) << " line: " << line() << "\")\n";
+                else
+                    err << "(error, \"unexpected char: " << c << " line: " << line() << "\")\n";
+                throw lex_error();
+            }
+            unsigned val = decimal_scan::scan(m_curr, m_end);
+            lit = neg ? -static_cast<int>(val) : static_cast<int>(val);
+            return true;
+        }
+    };
+
+#ifndef SINGLE_THREAD
+    /**
+       \brief literals of a chunk of the input, with 0 terminating clauses.
+    */
+    struct chunk {
+        char const*  m_begin;
+        char const*  m_end;
+        int_vector   m_lits;
+        unsigned     m_max_var { 0 };
+        bool         m_ok { true };
+        std::stringstream m_err;
+    };
+
+    static void scan_chunk(char const* file, chunk& c) {
+        memory_scanner in(file, c.m_begin, c.m_end);
+        int lit;
+        try {
+            while (in.next(lit, c.m_err)) {
+                c.m_lits.push_back(lit);
+                unsigned v = static_cast<unsigned>(abs(lit));
+                if (v > c.m_max_var)
+                    c.m_max_var = v;
+            }
+        }
+        catch (lex_error) {
+            c.m_ok = false;
+        }
+    }
+
+#endif
+
+    static void ensure_vars(sat::solver& solver, unsigned max_var) {
+        while (max_var >= solver.num_vars())
+            solver.mk_var();
+    }
+
+    static bool parse_sequential(char const* begin, char const* end, std::ostream& err, sat::solver& solver) {
+        memory_scanner in(begin, begin, end);
+        sat::literal_vector lits;
+        int lit;
+        try {
+            while (in.next(lit, err)) {
+                if (lit == 0) {
+                    solver.mk_clause(lits.size(), lits.data());
+                    lits.reset();
+                    continue;
+                }
+                unsigned v = static_cast<unsigned>(abs(lit));
+                if (v >= solver.num_vars())
+                    ensure_vars(solver, v);
+                lits.push_back(sat::literal(v, lit < 0));
+            }
+        }
+        catch (lex_error) {
+            return false;
+        }
+        if (!lits.empty()) {
+            err << "(error, \"unexpected end of file\")\n";
+            return false;
+        }
+        return true;
+    }
+
+    /**
+       \brief split the input into chunks at line boundaries and scan the chunks in parallel.
+       Clauses may span chunks, so the literals are added sequentially in order
+       once all chunks have been scanned.
+    */
+#ifndef SINGLE_THREAD
+    static bool parse_parallel(char const* begin, char const* end, std::ostream& err, sat::solver& solver, unsigned num_threads) {
+        scoped_ptr_vector<chunk> chunks;
+        size_t sz = static_cast<size_t>(end - begin);
+        char const* start = begin;
+        for (unsigned i = 1; i <= num_threads && start < end; ++i) {
+            char const* stop = i == num_threads ? end : begin + (sz / num_threads) * i;
+            if (stop < start)
+                stop = start;
+            while (stop < end && *stop != '\n')
+                ++stop;
+            if (stop < end)
+                ++stop;
+            chunk* c = alloc(chunk);
+            c->m_begin = start;
+            c->m_end = stop;
+            chunks.push_back(c);
+            start = stop;
+        }
+        if (chunks.size() <= 1)
+            return parse_sequential(begin, end, err, solver);
+
+        vector<std::thread> threads;
+        for (chunk* c : chunks)
+            threads.push_back(std::thread([&, c]() { scan_chunk(begin, *c); }));
+        for (auto& th : threads)
+            th.join();
+
+        unsigned max_var = 0;
+        for (chunk* c : chunks) {
+            if (!c->m_ok) {
+                err << c->m_err.str();
+                return false;
+            }
+            max_var = std::max(max_var, c->m_max_var);
+        }
+        ensure_vars(solver, max_var);
+        sat::literal_vector lits;
+        for (chunk* c : chunks) {
+            for (int lit : c->m_lits) {
+                if (lit == 0) {
+                    solver.mk_clause(lits.size(), lits.data());
+                    lits.reset();
+                }
+                else
+                    lits.push_back(sat::literal(static_cast<unsigned>(abs(lit)), lit < 0));
+            }
+            c->m_lits.finalize();
+        }
+        if (!lits.empty()) {
+            err << "(error, \"unexpected end of file\")\n";
+            return false;
+        }
+        return true;
+    }
+#endif
+}
+
+bool parse_dimacs(char const* begin, char const* end, std::ostream& err, sat::solver& solver, unsigned num_threads) {
+#ifndef SINGLE_THREAD
+    // small inputs are not worth starting threads for
+    if (num_threads > 1 && static_cast<size_t>(end - begin) >= (1u << 20))
+        return dimacs::parse_parallel(begin, end, err, solver, num_threads);
+#endif
+    return dimacs::parse_sequential(begin, end, err, solver);
+}
+
 
 namespace dimacs {
 
@@ -25,6 +25,12 @@ Revision History:
 
 bool parse_dimacs(std::istream & s, std::ostream& err, sat::solver & solver);
 
+/**
+   \brief parse a DIMACS file held in memory, such as a memory mapped file.
+   When num_threads > 1, large inputs are split into chunks that are scanned in parallel.
+*/
+bool parse_dimacs(char const* begin, char const* end, std::ostream& err, sat::solver & solver, unsigned num_threads = 1);
+
 namespace dimacs {
     struct lex_error {};
 
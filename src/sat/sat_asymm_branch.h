@@ -101,6 +101,9 @@ namespace sat {
         void collect_statistics(statistics & st) const;
         void reset_statistics();
 
+        unsigned num_elim_literals() const { return m_elim_literals + m_elim_learned_literals; }
+        unsigned num_tr() const { return m_tr; }
+
         void init_search() { m_calls = 0; }
 
         inline void dec(unsigned c) { m_counter -= c; }
@@ -21,14 +21,83 @@ Revision History:
 
 namespace sat {
 
+    clause** clause_arena::allocate(unsigned n) {
+        SASSERT(n > 0);
+        unsigned k = log2(n);
+        if ((1u << k) < n)
+            ++k;
+        if (k < c_num_classes && m_free[k]) {
+            clause** r = m_free[k];
+            m_free[k] = reinterpret_cast<clause**>(r[0]);
+            return r;
+        }
+        if (static_cast<size_t>(m_end - m_curr) < n) {
+            unsigned sz = n > c_block_size ? n : c_block_size;
+            m_curr = alloc_svect(clause*, sz);
+            m_end = m_curr + sz;
+            m_blocks.push_back(m_curr);
+        }
+        clause** r = m_curr;
+        m_curr += n;
+        return r;
+    }
+
+    void clause_arena::deallocate(clause** p, unsigned n) {
+        SASSERT(n > 0);
+        unsigned k = log2(n);
+        p[0] = reinterpret_cast<clause*>(m_free[k]);
+        m_free[k] = p;
+    }
+
+    void clause_arena::reset() {
+        for (clause** b : m_blocks)
+            dealloc_svect(b);
+        m_blocks.finalize();
+        m_curr = m_end = nullptr;
+        for (unsigned k = 0; k < c_num_classes; ++k)
+            m_free[k] = nullptr;
+    }
+
+    void clause_use_list::grow(clause_arena& a) {
+        unsigned new_capacity = std::max(4u, 2 * m_capacity);
+        clause** new_clauses = a.allocate(new_capacity);
+        for (unsigned i = 0; i < m_num_entries; ++i)
+            new_clauses[i] = m_clauses[i];
+        if (m_clauses)
+            a.deallocate(m_clauses, m_capacity);
+        m_clauses = new_clauses;
+        m_capacity = new_capacity;
+    }
+
+    bool clause_use_list::contains(clause const& c) const {
+        for (clause* d : *this)
+            if (d == &c)
+                return true;
+        return false;
+    }
+
+    void clause_use_list::erase_not_removed(clause & c) { 
+        STRACE("clause_use_list_bug", tout << "[cul_erase_not_removed] " << this << " " << &c << "\n";);
+        SASSERT(contains(c)); 
+        SASSERT(!c.was_removed()); 
+        unsigned i = 0;
+        while (m_clauses[i] != &c)
+            ++i;
+        for (++i; i < m_num_entries; ++i)
+            m_clauses[i - 1] = m_clauses[i];
+        m_num_entries--;
+        m_size--; 
+        if (c.is_learned()) --m_num_redundant;
+    }
+
     bool clause_use_list::check_invariant() const {
         unsigned sz = 0;
-        for (clause* c : m_clauses) 
+        for (clause* c : *this) 
             if (!c->was_removed())
                 sz++;
         SASSERT(sz == m_size);
         unsigned redundant = 0;
-        for (clause* c : m_clauses) 
+        for (clause* c : *this) 
             if (c->is_learned())
                 redundant++;
         SASSERT(redundant == m_num_redundant);
@@ -40,8 +109,8 @@ namespace sat {
         while (true) {
             if (m_i == m_size)
                 return;
-            if (!m_clauses[m_i]->was_removed()) {
-                m_clauses[m_j] = m_clauses[m_i];
+            if (!m_list.m_clauses[m_i]->was_removed()) {
+                m_list.m_clauses[m_j] = m_list.m_clauses[m_i];
                 return;
             }
             m_i++;
@@ -51,7 +120,7 @@ namespace sat {
     clause_use_list::iterator::~iterator() {
         while (m_i < m_size)
             next();
-        m_clauses.shrink(m_j);
+        m_list.m_num_entries = m_j;
     }
 
 };
@@ -23,16 +23,55 @@ Revision History:
 
 namespace sat {
 
+    /**
+       \brief Arena for the entries of clause use lists.
+
+       Entries are allocated in large blocks that are released
+       together when the use lists are rebuilt. Entries released by
+       a use list that grows are kept in free lists by size class,
+       where class k holds arrays with at least 2^k entries, and 
+       reused by later allocations.
+    */
+    class clause_arena {
+        static const unsigned c_block_size = 1 << 16;
+        static const unsigned c_num_classes = 32;
+        ptr_vector<clause*> m_blocks;
+        clause**            m_curr { nullptr };
+        clause**            m_end { nullptr };
+        clause**            m_free[c_num_classes];  // the first entry of a free array links to the next one
+        clause_arena(clause_arena const&) = delete;
+        clause_arena& operator=(clause_arena const&) = delete;
+    public:
+        clause_arena() { reset(); }
+        ~clause_arena() { reset(); }
+        clause** allocate(unsigned n);
+        void deallocate(clause** p, unsigned n);
+        void reset();
+    };
+
     /**
        \brief Clause use list with delayed deletion.
+
+       The entries of the list are stored in a clause_arena owned by the 
+       use_list of the simplifier. Lists are sized in bulk when 
+       the use lists are rebuilt and relocated within the arena 
+       when they grow. The old entries are returned to the arena.
     */
     class clause_use_list {
-        clause_vector   m_clauses;
+        clause**        m_clauses;
+        unsigned        m_num_entries;   // number of entries, including removed clauses
+        unsigned        m_capacity;
         unsigned        m_size;
         unsigned        m_num_redundant;
+
+        bool contains(clause const& c) const;
+        void grow(clause_arena& a);
     public:
         clause_use_list() {
             STRACE("clause_use_list_bug", tout << "[cul_created] " << this << "\n";);
+            m_clauses = nullptr;
+            m_num_entries = 0;
+            m_capacity = 0;
             m_size = 0; 
             m_num_redundant = 0;
         }
@@ -50,28 +89,37 @@ namespace sat {
         }
 
         bool empty() const { return size() == 0; }
+
+        /**
+           \brief count one more entry for a list that has not been allocated yet.
+        */
+        void reserve_one() { SASSERT(!m_clauses); ++m_capacity; }
+
+        /**
+           \brief allocate the capacity accumulated by reserve_one from the arena.
+        */
+        void allocate(clause_arena& a) {
+            SASSERT(!m_clauses && m_num_entries == 0);
+            if (m_capacity > 0)
+                m_clauses = a.allocate(m_capacity);
+        }
         
-        void insert(clause & c) { 
+        void insert(clause & c, clause_arena& a) { 
             STRACE("clause_use_list_bug", tout << "[cul_insert] " << this << " " << &c << "\n";);
-            SASSERT(!m_clauses.contains(&c)); 
+            SASSERT(!contains(c)); 
             SASSERT(!c.was_removed()); 
-            m_clauses.push_back(&c); 
+            if (m_num_entries == m_capacity)
+                grow(a);
+            m_clauses[m_num_entries++] = &c; 
             m_size++; 
             if (c.is_learned()) ++m_num_redundant;
         }
 
-        void erase_not_removed(clause & c) { 
-            STRACE("clause_use_list_bug", tout << "[cul_erase_not_removed] " << this << " " << &c << "\n";);
-            SASSERT(m_clauses.contains(&c)); 
-            SASSERT(!c.was_removed()); 
-            m_clauses.erase(&c); 
-            m_size--; 
-            if (c.is_learned()) --m_num_redundant;
-        }
+        void erase_not_removed(clause & c);
 
         void erase(clause & c) { 
             STRACE("clause_use_list_bug", tout << "[cul_erase] " << this << " " << &c << "\n";);
-            SASSERT(m_clauses.contains(&c)); 
+            SASSERT(contains(c)); 
             // SASSERT(c.was_removed()); 
             m_size--; 
             if (c.is_learned()) --m_num_redundant;
@@ -89,40 +137,55 @@ namespace sat {
             SASSERT(check_invariant());
         }
         
+        /**
+           \brief reset the list and return its entries to the arena.
+        */
+        void reset(clause_arena& a) {
+            if (m_clauses && m_capacity > 0)
+                a.deallocate(m_clauses, m_capacity);
+            reset();
+        }
+
         void reset() { 
-            m_clauses.finalize(); 
+            m_clauses = nullptr;
+            m_num_entries = 0;
+            m_capacity = 0;
             m_size = 0; 
             m_num_redundant = 0;
         }
         
         bool check_invariant() const;
 
+        // read-only access to the entries. It includes removed clauses.
+        clause* const* begin() const { return m_clauses; }
+        clause* const* end() const { return m_clauses + m_num_entries; }
+
         // iterate & compress
         class iterator {            
-            clause_vector & m_clauses;
+            clause_use_list & m_list;
             unsigned        m_size;
             unsigned        m_i;
             unsigned        m_j;
             void consume();
 
         public:
-            iterator(clause_vector & v):m_clauses(v), m_size(v.size()), m_i(0) {
+            iterator(clause_use_list & l):m_list(l), m_size(l.m_num_entries), m_i(0) {
                 m_j = 0;
                 consume(); 
             }
             ~iterator();
             bool at_end() const { return m_i == m_size; }
-            clause & curr() const { SASSERT(!at_end()); return *(m_clauses[m_i]); }
+            clause & curr() const { SASSERT(!at_end()); return *(m_list.m_clauses[m_i]); }
             void next() { 
                 SASSERT(!at_end()); 
-                SASSERT(!m_clauses[m_i]->was_removed()); 
+                SASSERT(!m_list.m_clauses[m_i]->was_removed()); 
                 m_i++; 
                 m_j++; 
                 consume(); 
             }
         };
         
-        iterator mk_iterator() const { return iterator(const_cast<clause_use_list*>(this)->m_clauses); }
+        iterator mk_iterator() const { return iterator(const_cast<clause_use_list&>(*this)); }
 
         std::ostream& display(std::ostream& out) const {
             iterator it = mk_iterator();
@@ -135,4 +198,3 @@ namespace sat {
     };
 
 };
-
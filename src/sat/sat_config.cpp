@@ -79,6 +79,8 @@ namespace sat {
         m_propagate_prefetch = p.propagate_prefetch();
         m_inprocess_max   = p.inprocess_max();
         m_inprocess_out   = p.inprocess_out();
+        m_inprocess_adaptive = p.inprocess_adaptive();
+        m_inprocess_max_delay = p.inprocess_max_delay();
 
         m_random_freq     = p.random_freq();
         m_random_seed     = p.random_seed();
@@ -91,6 +93,12 @@ namespace sat {
         
         m_max_conflicts   = p.max_conflicts();
         m_num_threads     = p.threads();
+        m_par_max_size    = p.par_max_size();
+        m_par_max_glue    = p.par_max_glue();
+        m_par_buffer_size = p.par_buffer_size();
+        m_par_import_interval = p.par_import_interval();
+        m_cube_and_conquer = p.cube_and_conquer();
+        m_cube_and_conquer_conflicts = p.cube_and_conquer_conflicts();
         m_ddfw_search     = p.ddfw_search();
         m_ddfw_threads    = p.ddfw_threads();
         m_prob_search     = p.prob_search();
@@ -196,7 +204,20 @@ namespace sat {
         m_drat_file       = p.drat_file();
         m_drat            = (m_drat_check_unsat || m_drat_file.is_non_empty_string() || m_drat_check_sat) && p.threads() == 1;
         m_drat_binary     = p.drat_binary();
+        m_drat_async      = p.drat_async();
         m_drat_activity   = p.drat_activity();
+
+        m_events_file     = p.events_file();
+        s = p.events_format();
+        if (s == symbol("csv"))
+            m_events_json = false;
+        else if (s == symbol("json"))
+            m_events_json = true;
+        else
+            throw sat_param_exception("invalid events format: csv or json");
+        m_events_interval = p.events_interval();
+        m_events_buffer_size = p.events_buffer_size();
+
         m_dyn_sub_res     = p.dyn_sub_res();
 
         // Parameters used in Liang, Ganesh, Poupart, Czarnecki AAAI 2016.
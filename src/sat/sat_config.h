@@ -105,12 +105,20 @@ namespace sat {
         double             m_slow_glue_avg;
         unsigned           m_inprocess_max;
         symbol             m_inprocess_out;
+        bool               m_inprocess_adaptive;
+        unsigned           m_inprocess_max_delay;
         double             m_random_freq;
         unsigned           m_random_seed;
         unsigned           m_burst_search;
         bool               m_enable_pre_simplify;
         unsigned           m_max_conflicts;
         unsigned           m_num_threads;
+        unsigned           m_par_max_size;
+        unsigned           m_par_max_glue;
+        unsigned           m_par_buffer_size;
+        unsigned           m_par_import_interval;
+        bool               m_cube_and_conquer;
+        unsigned           m_cube_and_conquer_conflicts;
         bool               m_ddfw_search;
         unsigned           m_ddfw_threads;
         bool               m_prob_search;
@@ -176,10 +184,17 @@ namespace sat {
         // drat proofs
         bool               m_drat;
         bool               m_drat_binary;
+        bool               m_drat_async;
         symbol             m_drat_file;
         bool               m_drat_check_unsat;
         bool               m_drat_check_sat;
         bool               m_drat_activity;
+
+        // event log
+        symbol             m_events_file;
+        bool               m_events_json;
+        unsigned           m_events_interval;
+        unsigned           m_events_buffer_size;
         
         bool               m_card_solver;
         bool               m_xor_solver;
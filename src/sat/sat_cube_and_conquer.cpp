@@ -0,0 +1,416 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    sat_cube_and_conquer.cpp
+
+Abstract:
+
+    Cube and conquer driver for the SAT solver.
+
+Revision History:
+
+--*/
+#include "sat/sat_cube_and_conquer.h"
+#include "sat/sat_solver.h"
+#ifndef SINGLE_THREAD
+#include <thread>
+#endif
+
+namespace sat {
+
+    void cube_and_conquer::cube_queue::push(literal_vector const& cube) {
+        lock_guard lock(m_mux);
+        m_cubes.push_back(cube);
+    }
+
+    bool cube_and_conquer::cube_queue::pop_back(literal_vector& cube) {
+        lock_guard lock(m_mux);
+        if (m_head == m_cubes.size())
+            return false;
+        cube.reset();
+        cube.append(m_cubes.back());
+        m_cubes.pop_back();
+        if (m_head == m_cubes.size()) {
+            m_cubes.reset();
+            m_head = 0;
+        }
+        return true;
+    }
+
+    bool cube_and_conquer::cube_queue::steal(literal_vector& cube) {
+        lock_guard lock(m_mux);
+        if (m_head == m_cubes.size())
+            return false;
+        cube.reset();
+        cube.append(m_cubes[m_head++]);
+        if (m_head == m_cubes.size()) {
+            m_cubes.reset();
+            m_head = 0;
+        }
+        return true;
+    }
+
+    cube_and_conquer::cube_and_conquer(solver& s):
+        m_solver(s),
+        m_num_vars(s.num_vars()),
+        m_scoped_rlimit(s.rlimit()),
+        m_num_queued(0),
+        m_num_pending(0),
+        m_done(false),
+        m_result(l_undef),
+        m_winner(-1) {}
+
+    void cube_and_conquer::init_workers(unsigned num_workers) {
+        params_ref p;
+        p.copy(m_solver.m_params);
+        p.set_uint("threads", 1);
+        p.set_uint("local_search_threads", 0);
+        p.set_uint("ddfw.threads", 0);
+        p.set_bool("cube_and_conquer", false);
+        p.set_sym("events.file", symbol::null);
+        // a conflict budget of 0 means that cubes are solved without splitting them further.
+        unsigned max_conflicts = m_solver.get_config().m_cube_and_conquer_conflicts;
+        p.set_uint("max_conflicts", max_conflicts == 0 ? UINT_MAX : max_conflicts);
+        m_limits.init(num_workers);
+        for (unsigned i = 0; i < num_workers; ++i) {
+            p.set_uint("random_seed", m_solver.m_rand());
+            solver* w = alloc(solver, p, m_limits[i]);
+            w->copy(m_solver, true);
+            // cubes from one worker are solved by other workers,
+            // so none of the workers may eliminate variables.
+            w->set_incremental(true);
+            for (bool_var v = 0; v < m_num_vars; ++v)
+                w->set_external(v);
+            m_workers.push_back(w);
+            m_queues.push_back(alloc(cube_queue));
+            m_scoped_rlimit.push_child(&w->rlimit());
+        }
+    }
+
+    bool cube_and_conquer::is_done() {
+        lock_guard lock(m_mux);
+        return m_done;
+    }
+
+    bool cube_and_conquer::get_cube(unsigned id, literal_vector& cube) {
+        if (m_queues[id]->pop_back(cube)) {
+            lock_guard lock(m_mux);
+            --m_num_queued;
+            return true;
+        }
+        unsigned n = m_queues.size();
+        for (unsigned k = 1; k < n; ++k) {
+            if (m_queues[(id + k) % n]->steal(cube)) {
+                lock_guard lock(m_mux);
+                --m_num_queued;
+                ++m_stats.m_num_steals;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+       \brief block until some worker queues a cube or the search is done.
+       Cubes are queued under m_mux, so a cube queued after get_cube failed is not missed.
+     */
+    void cube_and_conquer::wait_for_cube() {
+#ifndef SINGLE_THREAD
+        std::unique_lock<std::mutex> lock(m_mux);
+        m_cond.wait(lock, [&]() { return m_done || m_num_queued > 0; });
+#endif
+    }
+
+    /**
+       \brief set the result and release workers waiting for cubes. m_mux must be held.
+     */
+    void cube_and_conquer::set_done(lbool r) {
+        m_done = true;
+        m_result = r;
+#ifndef SINGLE_THREAD
+        m_cond.notify_all();
+#endif
+    }
+
+    /**
+       \brief import units and lemmas that were found by other workers since the last call.
+     */
+    void cube_and_conquer::sync(unsigned id, unsigned& units_lim, unsigned& lemmas_lim) {
+        solver& w = *m_workers[id];
+        literal_vector units;
+        vector<literal_vector> lemmas;
+        {
+            lock_guard lock(m_mux);
+            units.append(m_units.size() - units_lim, m_units.data() + units_lim);
+            for (unsigned i = lemmas_lim; i < m_lemmas.size(); ++i)
+                lemmas.push_back(m_lemmas[i]);
+            units_lim = m_units.size();
+            lemmas_lim = m_lemmas.size();
+        }
+        w.pop_to_base_level();
+        for (literal lit : units) {
+            if (w.inconsistent())
+                return;
+            if (w.value(lit) != l_true)
+                w.mk_clause(1, &lit, sat::status::asserted());
+        }
+        for (literal_vector& lemma : lemmas) {
+            if (w.inconsistent())
+                return;
+            w.mk_clause(lemma.size(), lemma.data(), sat::status::asserted());
+        }
+    }
+
+    void cube_and_conquer::export_units(solver& w) {
+        unsigned sz = w.init_trail_size();
+        lock_guard lock(m_mux);
+        for (unsigned i = 0; i < sz; ++i) {
+            literal lit = w.m_trail[i];
+            if (lit.var() < m_num_vars && !m_unit_set.contains(lit.index())) {
+                m_unit_set.insert(lit.index());
+                m_units.push_back(lit);
+                ++m_stats.m_num_units;
+            }
+        }
+    }
+
+    /**
+       \brief record that cube was refuted by worker w.
+       If the core does not depend on the cube, then the assumptions are unsatisfiable.
+       Otherwise the negation of the core is shared as a lemma and the assumption
+       literals of the core are added to the final core.
+     */
+    void cube_and_conquer::refuted(solver& w, literal_vector const& cube) {
+        literal_vector const& core = w.get_core();
+        bool uses_cube = false;
+        for (literal lit : core)
+            uses_cube |= cube.contains(lit);
+        lock_guard lock(m_mux);
+        ++m_stats.m_num_refuted;
+        for (literal lit : core) {
+            if (m_assumptions.contains(lit) && !m_core_set.contains(lit.index())) {
+                m_core_set.insert(lit.index());
+                m_core.push_back(lit);
+            }
+        }
+        if (!uses_cube) {
+            m_core.reset();
+            m_core.append(core);
+            m_num_pending = 0;
+        }
+        else {
+            literal_vector lemma;
+            for (literal lit : core)
+                lemma.push_back(~lit);
+            m_lemmas.push_back(lemma);
+            ++m_stats.m_num_lemmas;
+            --m_num_pending;
+        }
+        if (m_num_pending == 0 && !m_done) 
+            set_done(l_false);
+    }
+
+    void cube_and_conquer::finish(int id, lbool r) {
+        lock_guard lock(m_mux);
+        if (m_done)
+            return;
+        set_done(r);
+        m_winner = id;
+        for (unsigned j = 0; j < m_limits.size(); ++j)
+            if (static_cast<int>(j) != id)
+                m_limits[j].cancel();
+    }
+
+    /**
+       \brief split cube into sub-cubes using lookahead on a copy of w.
+       The copy includes all clauses of w, so each split costs time and memory
+       proportional to the size of the clause database.
+       Returns l_false if lookahead refutes the cube, l_true if lookahead finds
+       a model (the cube is then extended by the model) and l_undef otherwise.
+     */
+    lbool cube_and_conquer::split(solver& w, literal_vector const& cube, unsigned depth, vector<literal_vector>& cubes) {
+        params_ref p;
+        p.copy(w.m_params);
+        p.set_sym("lookahead.cube.cutoff", symbol("depth"));
+        p.set_uint("lookahead.cube.depth", depth);
+        solver tmp(p, w.rlimit());
+        tmp.copy(w, false);
+        for (literal lit : m_assumptions)
+            tmp.mk_clause(1, &lit, sat::status::asserted());
+        for (literal lit : cube)
+            tmp.mk_clause(1, &lit, sat::status::asserted());
+        if (tmp.inconsistent())
+            return l_false;
+
+        bool_var_vector vars;
+        literal_vector lits;
+        while (true) {
+            lbool r = tmp.cube(vars, lits, UINT_MAX);
+            if (r == l_false)
+                return cubes.empty() ? l_false : l_undef;
+            if (r == l_true) {
+                cubes.reset();
+                literal_vector ext(cube);
+                model const& mdl = tmp.get_model();
+                for (bool_var v = 0; v < mdl.size() && v < m_num_vars; ++v)
+                    if (mdl[v] != l_undef)
+                        ext.push_back(literal(v, mdl[v] == l_false));
+                cubes.push_back(ext);
+                return l_true;
+            }
+            if (lits.empty())
+                return l_undef;
+            literal_vector sub(cube);
+            sub.append(lits);
+            cubes.push_back(sub);
+            vars.reset();
+        }
+    }
+
+    void cube_and_conquer::run(unsigned id) {
+        solver& w = *m_workers[id];
+        unsigned units_lim = 0, lemmas_lim = 0;
+        literal_vector cube, asms;
+        vector<literal_vector> cubes;
+        while (!is_done() && w.rlimit().inc()) {
+            if (!get_cube(id, cube)) {
+                wait_for_cube();
+                continue;
+            }
+            sync(id, units_lim, lemmas_lim);
+            asms.reset();
+            asms.append(m_assumptions);
+            asms.append(cube);
+            IF_VERBOSE(2, verbose_stream() << "(sat.cube-and-conquer :worker " << id << " :cube " << cube.size() << ")\n";);
+            lbool r = w.check(asms.size(), asms.data());
+            export_units(w);
+            if (r == l_true) {
+                finish(id, l_true);
+                break;
+            }
+            if (r == l_false) {
+                refuted(w, cube);
+                continue;
+            }
+            if (!w.rlimit().inc())
+                break;
+            // the conflict budget for the cube was exhausted, split it further.
+            cubes.reset();
+            lbool s = split(w, cube, 1, cubes);
+            lock_guard lock(m_mux);
+            if (s == l_false) {
+                ++m_stats.m_num_refuted;
+                for (literal lit : m_assumptions) {
+                    if (!m_core_set.contains(lit.index())) {
+                        m_core_set.insert(lit.index());
+                        m_core.push_back(lit);
+                    }
+                }
+                if (--m_num_pending == 0 && !m_done) 
+                    set_done(l_false);
+                continue;
+            }
+            if (cubes.empty())
+                cubes.push_back(cube);
+            ++m_stats.m_num_splits;
+            m_stats.m_num_cubes += cubes.size();
+            m_num_pending += cubes.size() - 1;
+            m_num_queued += cubes.size();
+            for (literal_vector const& c : cubes)
+                m_queues[id]->push(c);
+#ifndef SINGLE_THREAD
+            m_cond.notify_all();
+#endif
+        }
+    }
+
+#ifdef SINGLE_THREAD
+    lbool cube_and_conquer::operator()(unsigned num_lits, literal const* lits) {
+        // solver::check uses sequential search instead of cube and conquer without threads.
+        UNREACHABLE();
+        return l_undef;
+    }
+#else
+    lbool cube_and_conquer::operator()(unsigned num_lits, literal const* lits) {
+        if (!m_solver.rlimit().inc())
+            return l_undef;
+        m_assumptions.append(num_lits, lits);
+        unsigned num_workers = std::max(1u, m_solver.get_config().m_num_threads);
+        init_workers(num_workers);
+
+        // create enough initial cubes to keep all workers busy.
+        unsigned depth = 1;
+        while ((1u << depth) < 2 * num_workers)
+            ++depth;
+        vector<literal_vector> cubes;
+        lbool r = split(*m_workers[0], literal_vector(), depth, cubes);
+        if (r == l_false) {
+            m_solver.m_core.reset();
+            m_solver.m_core.append(m_assumptions);
+            return l_false;
+        }
+        if (cubes.empty())
+            cubes.push_back(literal_vector());
+        m_stats.m_num_cubes = cubes.size();
+        m_num_pending = cubes.size();
+        m_num_queued = cubes.size();
+        for (unsigned i = 0; i < cubes.size(); ++i)
+            m_queues[i % num_workers]->push(cubes[i]);
+        IF_VERBOSE(1, verbose_stream() << "(sat.cube-and-conquer :workers " << num_workers << " :cubes " << cubes.size() << ")\n";);
+
+        std::string ex_msg;
+        bool has_ex = false;
+        unsigned error_code = 0;
+        bool is_error = false;
+        std::mutex ex_mux;
+        auto worker_thread = [&](unsigned i) {
+            try {
+                run(i);
+            }
+            catch (z3_error& err) {
+                std::lock_guard<std::mutex> lock(ex_mux);
+                has_ex = is_error = true;
+                error_code = err.error_code();
+            }
+            catch (z3_exception& ex) {
+                std::lock_guard<std::mutex> lock(ex_mux);
+                has_ex = true;
+                ex_msg = ex.msg();
+            }
+            // release the other workers if this one is gone.
+            finish(-1, l_undef);
+        };
+        vector<std::thread> threads(num_workers);
+        for (unsigned i = 0; i < num_workers; ++i)
+            threads[i] = std::thread([&, i]() { worker_thread(i); });
+        for (auto& th : threads)
+            th.join();
+
+        if (m_result == l_undef && has_ex) {
+            if (is_error)
+                throw z3_error(error_code);
+            throw default_exception(std::move(ex_msg));
+        }
+        if (m_result == l_true && m_winner >= 0)
+            m_solver.set_model(m_workers[m_winner]->get_model(), true);
+        if (m_result == l_false) {
+            m_solver.m_core.reset();
+            m_solver.m_core.append(m_core);
+        }
+        collect_statistics(m_solver.m_aux_stats);
+        return m_result;
+    }
+#endif
+
+    void cube_and_conquer::collect_statistics(statistics& st) const {
+        st.update("sat cc cubes", m_stats.m_num_cubes);
+        st.update("sat cc refuted", m_stats.m_num_refuted);
+        st.update("sat cc splits", m_stats.m_num_splits);
+        st.update("sat cc steals", m_stats.m_num_steals);
+        st.update("sat cc units", m_stats.m_num_units);
+        st.update("sat cc lemmas", m_stats.m_num_lemmas);
+    }
+
+};
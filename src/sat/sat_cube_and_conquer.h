@@ -0,0 +1,109 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    sat_cube_and_conquer.h
+
+Abstract:
+
+    Cube and conquer driver for the SAT solver.
+
+    The problem is split into cubes using lookahead. Cubes are
+    solved by a pool of incremental solvers, one per thread.
+    Each worker owns a queue of cubes and steals from other
+    queues when its own queue is empty. A cube that is not solved
+    within a conflict budget is split again using lookahead.
+    Units and negated cores of refuted cubes are shared between workers.
+
+Revision History:
+
+--*/
+#pragma once
+
+#include "sat/sat_types.h"
+#include "util/hashtable.h"
+#include "util/map.h"
+#include "util/rlimit.h"
+#include "util/scoped_ptr_vector.h"
+#include "util/statistics.h"
+#include "util/mutex.h"
+#ifndef SINGLE_THREAD
+#include <condition_variable>
+#endif
+
+namespace sat {
+
+    class cube_and_conquer {
+
+        // cubes owned by a worker. The owner takes cubes from the back,
+        // other workers steal cubes from the front.
+        struct cube_queue {
+            mutex                  m_mux;
+            vector<literal_vector> m_cubes;
+            unsigned               m_head { 0 };
+            void push(literal_vector const& cube);
+            bool pop_back(literal_vector& cube);
+            bool steal(literal_vector& cube);
+        };
+
+        struct stats {
+            unsigned m_num_cubes;
+            unsigned m_num_refuted;
+            unsigned m_num_splits;
+            unsigned m_num_steals;
+            unsigned m_num_units;
+            unsigned m_num_lemmas;
+            stats() { reset(); }
+            void reset() { memset(this, 0, sizeof(*this)); }
+        };
+
+        typedef hashtable<unsigned, u_hash, u_eq> index_set;
+
+        solver&                        m_solver;
+        unsigned                       m_num_vars;
+        literal_vector                 m_assumptions;
+        scoped_limits                  m_scoped_rlimit;
+        vector<reslimit>               m_limits;
+        scoped_ptr_vector<solver>      m_workers;
+        scoped_ptr_vector<cube_queue>  m_queues;
+
+        // state shared between workers, protected by m_mux
+        mutex                          m_mux;
+#ifndef SINGLE_THREAD
+        std::condition_variable        m_cond;      // signaled when cubes are queued or the search is done
+#endif
+        unsigned                       m_num_queued;
+        literal_vector                 m_units;
+        index_set                      m_unit_set;
+        vector<literal_vector>         m_lemmas;
+        literal_vector                 m_core;
+        index_set                      m_core_set;
+        unsigned                       m_num_pending;
+        bool                           m_done;
+        lbool                          m_result;
+        int                            m_winner;
+        stats                          m_stats;
+
+        void init_workers(unsigned num_workers);
+        bool get_cube(unsigned id, literal_vector& cube);
+        void wait_for_cube();
+        void set_done(lbool r);
+        void sync(unsigned id, unsigned& units_lim, unsigned& lemmas_lim);
+        void export_units(solver& w);
+        void refuted(solver& w, literal_vector const& cube);
+        void finish(int id, lbool r);
+        lbool split(solver& w, literal_vector const& cube, unsigned depth, vector<literal_vector>& cubes);
+        void run(unsigned id);
+        bool is_done();
+
+    public:
+
+        cube_and_conquer(solver& s);
+
+        lbool operator()(unsigned num_lits, literal const* lits);
+
+        void collect_statistics(statistics& st) const;
+    };
+
+};
@@ -398,6 +398,21 @@ namespace sat {
             }
             m_par->to_solver(*this);
         }
+        // share the best assignment and the clause weights with other ddfw threads
+        // and continue from a better assignment if another thread found one.
+        unsigned_vector weights;
+        for (auto const& ci : m_clauses) 
+            weights.push_back(ci.m_weight);
+        unsigned num_unsat = m_min_sz;
+        if (!m_best_values.empty() && m_par->exchange_local_search(num_unsat, m_best_values, weights)) {
+            for (unsigned v = 0; v < num_vars() && v < m_best_values.size(); ++v)
+                value(v) = m_best_values[v];
+        }
+        for (unsigned i = 0; i < m_clauses.size(); ++i)
+            m_clauses[i].m_weight = weights[i];
+        init_clause_data();
+        if (m_unsat.size() <= m_min_sz)
+            save_best_values();
         ++m_parsync_count;
         m_parsync_next *= 3;
         m_parsync_next /= 2;
@@ -420,6 +435,11 @@ namespace sat {
                 }
             }
         }
+        if (m_par && (m_unsat.size() < m_min_sz || m_best_values.empty())) {
+            m_best_values.reset();
+            for (unsigned v = 0; v < num_vars(); ++v) 
+                m_best_values.push_back(value(v));
+        }
         unsigned h = value_hash();
         if (!m_models.contains(h)) {
             for (unsigned v = 0; v < num_vars(); ++v) {
@@ -21,11 +21,124 @@ Notes:
 --*/
 #include "sat_solver.h"
 #include "sat_drat.h"
+#ifndef SINGLE_THREAD
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#endif
 
 
 namespace sat {
+
+#ifndef SINGLE_THREAD
+    /**
+       \brief double buffered output to a file. 
+       The solver fills one page while a background thread writes the other page.
+       The solver only waits if it fills a page before the previous page is written.
+     */
+    class drat::async_buffer : public std::streambuf {
+        static const unsigned   c_page_size = 1 << 20;
+        std::ofstream           m_file;
+        char*                   m_pages[2];
+        unsigned                m_len[2];
+        unsigned                m_fill;     // page filled by the solver
+        bool                    m_pending;  // the other page is being written
+        bool                    m_done;
+        std::atomic<bool>       m_failed;   // opening or writing the file failed, read without the lock
+        std::mutex              m_mux;
+        std::condition_variable m_cond;
+        std::thread             m_writer;
+
+        void write_pages() {
+            std::unique_lock<std::mutex> lock(m_mux);
+            while (true) {
+                m_cond.wait(lock, [&]() { return m_pending || m_done; });
+                if (!m_pending) 
+                    break;
+                unsigned idx = 1 - m_fill;
+                lock.unlock();
+                m_file.write(m_pages[idx], m_len[idx]);
+                bool failed = m_file.fail();
+                lock.lock();
+                if (failed)
+                    m_failed = true;
+                m_pending = false;
+                m_cond.notify_all();
+            }
+        }
+
+        // returns false if the writer thread failed to write a previous page.
+        bool hand_off() {
+            unsigned len = static_cast<unsigned>(pptr() - pbase());
+            std::unique_lock<std::mutex> lock(m_mux);
+            m_cond.wait(lock, [&]() { return !m_pending; });
+            if (m_failed || len == 0)
+                return !m_failed;
+            m_len[m_fill] = len;
+            m_fill = 1 - m_fill;
+            m_pending = true;
+            m_cond.notify_all();
+            lock.unlock();
+            setp(m_pages[m_fill], m_pages[m_fill] + c_page_size);
+            return true;
+        }
+
+    protected:
+        int overflow(int ch) override {
+            if (!hand_off())
+                return traits_type::eof();
+            if (ch != traits_type::eof()) {
+                *pptr() = static_cast<char>(ch);
+                pbump(1);
+            }
+            return traits_type::not_eof(ch);
+        }
+
+        int sync() override {
+            if (!hand_off())
+                return -1;
+            std::unique_lock<std::mutex> lock(m_mux);
+            m_cond.wait(lock, [&]() { return !m_pending; });
+            m_file.flush();
+            if (m_file.fail())
+                m_failed = true;
+            return m_failed ? -1 : 0;
+        }
+
+    public:
+        bool failed() const { return m_failed; }
+
+        async_buffer(std::string const& file, std::ios_base::openmode mode): 
+            m_file(file, mode), m_fill(0), m_pending(false), m_done(false), m_failed(m_file.fail()) {
+            m_pages[0] = alloc_svect(char, c_page_size);
+            m_pages[1] = alloc_svect(char, c_page_size);
+            setp(m_pages[0], m_pages[0] + c_page_size);
+            m_writer = std::thread([&]() { write_pages(); });
+        }
+
+        ~async_buffer() override {
+            sync();
+            {
+                std::lock_guard<std::mutex> lock(m_mux);
+                m_done = true;
+                m_cond.notify_all();
+            }
+            m_writer.join();
+            dealloc_svect(m_pages[0]);
+            dealloc_svect(m_pages[1]);
+        }
+    };
+#else
+    class drat::async_buffer : public std::streambuf {
+    public:
+        bool failed() const { return false; }
+    };
+#endif
+
     drat::drat(solver& s) :
         s(s),
+        m_async(nullptr),
         m_out(nullptr),
         m_bout(nullptr),
         m_inconsistent(false),
@@ -36,7 +149,14 @@ namespace sat {
     {
         if (s.get_config().m_drat && s.get_config().m_drat_file.is_non_empty_string()) {
             auto mode = s.get_config().m_drat_binary ? (std::ios_base::binary | std::ios_base::out | std::ios_base::trunc) : std::ios_base::out;
-            m_out = alloc(std::ofstream, s.get_config().m_drat_file.str(), mode);
+#ifndef SINGLE_THREAD
+            if (s.get_config().m_drat_async) {
+                m_async = alloc(async_buffer, s.get_config().m_drat_file.str(), mode);
+                m_out = alloc(std::ostream, m_async);
+            }
+            else
+#endif
+                m_out = alloc(std::ofstream, s.get_config().m_drat_file.str(), mode);
             if (s.get_config().m_drat_binary) {
                 std::swap(m_out, m_bout);
             }
@@ -48,6 +168,7 @@ namespace sat {
         if (m_bout) m_bout->flush();
         dealloc(m_out);
         dealloc(m_bout);
+        dealloc(m_async);
         for (unsigned i = 0; i < m_proof.size(); ++i) {
             clause* c = m_proof[i];
             if (c) {
@@ -57,6 +178,7 @@ namespace sat {
         m_proof.reset();
         m_out = nullptr;
         m_bout = nullptr;
+        m_async = nullptr;
     }
 
     void drat::updt_config() {            
@@ -749,10 +871,25 @@ namespace sat {
         return status::asserted();
     }
 
+    void drat::check_output() const {
+        if ((m_out && m_out->fail()) || (m_bout && m_bout->fail()) || (m_async && m_async->failed())) 
+            throw default_exception("could not write DRAT proof to " + s.get_config().m_drat_file.str());
+    }
+
+    /**
+       \brief the empty clause completes the proof: make sure it reached the file.
+    */
+    void drat::flush_proof() {
+        if (m_out) m_out->flush();
+        if (m_bout) m_bout->flush();
+        check_output();
+    }
+
     void drat::add() {
         ++m_stats.m_num_add;
         if (m_out) (*m_out) << "0\n";
         if (m_bout) bdump(0, nullptr, status::redundant());
+        flush_proof();
         if (m_check_unsat) {
             verify(0, nullptr);
             SASSERT(m_inconsistent);
@@ -809,6 +946,8 @@ namespace sat {
         }
         if (m_out)
             dump(sz, lits, st);
+        if (sz == 0 && !st.is_deleted())
+            flush_proof();
     }
 
     void drat::add(literal_vector const& c) {
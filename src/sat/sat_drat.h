@@ -61,6 +61,7 @@ namespace sat {
     class clause;
 
     class drat {
+        class async_buffer;
         struct stats {
             unsigned m_num_drup { 0 };
             unsigned m_num_drat { 0 };
@@ -77,6 +78,7 @@ namespace sat {
         typedef svector<unsigned> watch;
         solver& s;
         clause_allocator        m_alloc;
+        async_buffer*           m_async;
         std::ostream*           m_out;
         std::ostream*           m_bout;
         ptr_vector<clause>      m_proof;
@@ -90,6 +92,7 @@ namespace sat {
         stats                   m_stats;
 
         void dump_activity();
+        void flush_proof();
         void dump(unsigned n, literal const* c, status st);
         void bdump(unsigned n, literal const* c, status st);
         void append(literal l, status st);
@@ -122,6 +125,9 @@ namespace sat {
 
         void updt_config();
 
+        // throw if the proof could not be written to drat.file
+        void check_output() const;
+
         void add_theory(int id, symbol const& s) { m_theory.setx(id, s.str(), std::string()); }
         void add();
         void add(literal l, bool learned);
@@ -0,0 +1,165 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    sat_event_log.cpp
+
+Abstract:
+
+    Time series of solver events for offline performance analysis.
+
+Revision History:
+
+--*/
+#include "sat/sat_event_log.h"
+#include "sat/sat_solver.h"
+
+namespace sat {
+
+    static char const* kind2str(event_log::kind k) {
+        switch (k) {
+        case event_log::kind::restart:   return "restart";
+        case event_log::kind::gc:        return "gc";
+        case event_log::kind::simplify:  return "simplify";
+        case event_log::kind::inprocess: return "inprocess";
+        case event_log::kind::interval:  return "interval";
+        }
+        return "";
+    }
+
+    event_log::event_log(solver& s, symbol const& file, bool json, unsigned buffer_size, unsigned interval):
+        s(s),
+        m_out(file.str()),
+        m_json(json),
+        m_interval(std::max(1u, interval)),
+        m_next_interval(m_interval) {
+        m_events.resize(std::max(1u, buffer_size));
+        memset(m_glue, 0, sizeof(m_glue));
+        if (!m_out)
+            throw default_exception("could not open file for sat events: " + file.str());
+        if (!m_json)
+            m_out << "time,event,name,conflicts,decisions,propagations,value1,value2,value3,glue\n";
+        m_watch.start();
+    }
+
+    event_log::~event_log() {
+        flush();
+    }
+
+    event_log::event& event_log::push(kind k) {
+        if (m_num_events == m_events.size())
+            flush();
+        event& e = m_events[m_num_events++];
+        e.m_kind = k;
+        e.m_name = "";
+        e.m_time = m_watch.get_current_seconds();
+        e.m_conflicts = s.m_stats.m_conflict;
+        e.m_decisions = s.m_stats.m_decision;
+        e.m_propagations = s.m_stats.m_propagate + s.m_stats.m_bin_propagate + s.m_stats.m_ter_propagate;
+        e.m_val1 = e.m_val2 = e.m_val3 = 0;
+        return e;
+    }
+
+    // value1 = fast glue average, value2 = slow glue average, value3 = trail size
+    void event_log::restart() {
+        event& e = push(kind::restart);
+        e.m_val1 = s.m_fast_glue_avg;
+        e.m_val2 = s.m_slow_glue_avg;
+        e.m_val3 = s.m_trail.size();
+    }
+
+    // value1 = learned clauses before gc, value2 = learned clauses after gc
+    void event_log::gc(unsigned num_learned_before, unsigned num_learned_after) {
+        event& e = push(kind::gc);
+        e.m_val1 = num_learned_before;
+        e.m_val2 = num_learned_after;
+    }
+
+    // value1 = seconds spent, value2 = irredundant clauses, value3 = learned clauses
+    void event_log::simplify(double time) {
+        event& e = push(kind::simplify);
+        e.m_val1 = time;
+        e.m_val2 = s.m_clauses.size();
+        e.m_val3 = s.m_learned.size();
+    }
+
+    // value1 = seconds spent, value2 = variables removed, value3 = clauses removed
+    void event_log::inprocess(char const* name, double time, unsigned vars_removed, unsigned clauses_removed) {
+        event& e = push(kind::inprocess);
+        e.m_name = name;
+        e.m_val1 = time;
+        e.m_val2 = vars_removed;
+        e.m_val3 = clauses_removed;
+    }
+
+    // value1 = propagations per second, value2 = decisions per second, value3 = learned clauses
+    void event_log::interval() {
+        m_next_interval = m_num_conflicts + m_interval;
+        event& e = push(kind::interval);
+        double dt = e.m_time - m_last_time;
+        if (dt > 0) {
+            e.m_val1 = (e.m_propagations - m_last_propagations) / dt;
+            e.m_val2 = (e.m_decisions - m_last_decisions) / dt;
+        }
+        e.m_val3 = s.m_learned.size();
+        memcpy(e.m_glue, m_glue, sizeof(m_glue));
+        memset(m_glue, 0, sizeof(m_glue));
+        m_last_time = e.m_time;
+        m_last_propagations = e.m_propagations;
+        m_last_decisions = e.m_decisions;
+        flush();
+    }
+
+    void event_log::flush() {
+        for (unsigned i = 0; i < m_num_events; ++i) {
+            if (m_json)
+                display_json(m_out, m_events[i]);
+            else
+                display_csv(m_out, m_events[i]);
+        }
+        m_num_events = 0;
+        m_out.flush();
+    }
+
+    void event_log::display_csv(std::ostream& out, event const& e) const {
+        out << e.m_time << "," << kind2str(e.m_kind) << "," << e.m_name << ","
+            << e.m_conflicts << "," << e.m_decisions << "," << e.m_propagations << ","
+            << e.m_val1 << "," << e.m_val2 << "," << e.m_val3 << ",";
+        if (e.m_kind == kind::interval) {
+            for (unsigned i = 0; i < c_glue_bins; ++i)
+                out << (i > 0 ? ";" : "") << e.m_glue[i];
+        }
+        out << "\n";
+    }
+
+    void event_log::display_json(std::ostream& out, event const& e) const {
+        out << "{\"time\":" << e.m_time << ",\"event\":\"" << kind2str(e.m_kind) << "\"" 
+            << ",\"conflicts\":" << e.m_conflicts
+            << ",\"decisions\":" << e.m_decisions
+            << ",\"propagations\":" << e.m_propagations;
+        switch (e.m_kind) {
+        case kind::restart:
+            out << ",\"fast_glue\":" << e.m_val1 << ",\"slow_glue\":" << e.m_val2 << ",\"trail\":" << e.m_val3;
+            break;
+        case kind::gc:
+            out << ",\"learned_before\":" << e.m_val1 << ",\"learned_after\":" << e.m_val2;
+            break;
+        case kind::simplify:
+            out << ",\"seconds\":" << e.m_val1 << ",\"clauses\":" << e.m_val2 << ",\"learned\":" << e.m_val3;
+            break;
+        case kind::inprocess:
+            out << ",\"technique\":\"" << e.m_name << "\",\"seconds\":" << e.m_val1 
+                << ",\"vars_removed\":" << e.m_val2 << ",\"clauses_removed\":" << e.m_val3;
+            break;
+        case kind::interval:
+            out << ",\"propagations_per_second\":" << e.m_val1 << ",\"decisions_per_second\":" << e.m_val2
+                << ",\"learned\":" << e.m_val3 << ",\"glue\":[";
+            for (unsigned i = 0; i < c_glue_bins; ++i)
+                out << (i > 0 ? "," : "") << e.m_glue[i];
+            out << "]";
+            break;
+        }
+        out << "}\n";
+    }
+};
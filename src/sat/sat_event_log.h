@@ -0,0 +1,109 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    sat_event_log.h
+
+Abstract:
+
+    Time series of solver events for offline performance analysis.
+
+    Events are restarts, garbage collection rounds, simplification
+    rounds, inprocessing passes and interval events. Interval events are
+    recorded every sat.events.interval conflicts and contain the
+    propagation and decision rates since the previous interval and the 
+    histogram of the glue of clauses learned in the interval.
+
+    Events are buffered in memory and written to sat.events.file
+    when the buffer is full, at interval events and when a search
+    ends. The output is either CSV with columns
+
+       time,event,name,conflicts,decisions,propagations,value1,value2,value3,glue
+
+    or one JSON object per line.
+    The solver only checks for a null pointer when the log is disabled.
+
+Revision History:
+
+--*/
+#pragma once
+
+#include <fstream>
+#include "util/stopwatch.h"
+#include "util/symbol.h"
+#include "sat/sat_types.h"
+
+namespace sat {
+    class solver;
+
+    class event_log {
+    public:
+        static const unsigned c_glue_bins = 16;
+
+        enum class kind { restart, gc, simplify, inprocess, interval };
+
+    private:
+        struct event {
+            kind        m_kind;
+            char const* m_name;
+            double      m_time;
+            unsigned    m_conflicts;
+            unsigned    m_decisions;
+            unsigned    m_propagations; // binary, ternary and other clauses
+            double      m_val1;
+            double      m_val2;
+            double      m_val3;
+            unsigned    m_glue[c_glue_bins];
+        };
+
+        solver&         s;
+        std::ofstream   m_out;
+        bool            m_json;
+        svector<event>  m_events;
+        unsigned        m_num_events { 0 };
+        unsigned        m_interval;
+        unsigned        m_num_conflicts { 0 };
+        unsigned        m_next_interval;
+        stopwatch       m_watch;
+        double          m_last_time { 0 };
+        unsigned        m_last_decisions { 0 };
+        unsigned        m_last_propagations { 0 };
+        unsigned        m_glue[c_glue_bins];
+
+        event& push(kind k);
+        void interval();
+        void display_csv(std::ostream& out, event const& e) const;
+        void display_json(std::ostream& out, event const& e) const;
+
+    public:
+        event_log(solver& s, symbol const& file, bool json, unsigned buffer_size, unsigned interval);
+        ~event_log();
+
+        void restart();
+        void gc(unsigned num_learned_before, unsigned num_learned_after);
+        void simplify(double time);
+        void inprocess(char const* name, double time, unsigned vars_removed, unsigned clauses_removed);
+
+        void conflict() {
+            if (++m_num_conflicts >= m_next_interval)
+                interval();
+        }
+
+        void learned(unsigned glue) {
+            ++m_glue[glue < c_glue_bins ? glue : c_glue_bins - 1];
+        }
+
+        void flush();
+    };
+
+    /**
+       \brief Flush the event log, if there is one, when a search ends.
+    */
+    class scoped_event_log_flush {
+        event_log* m_log;
+    public:
+        scoped_event_log_flush(event_log* log): m_log(log) {}
+        ~scoped_event_log_flush() { if (m_log) m_log->flush(); }
+    };
+};
@@ -40,6 +40,7 @@ namespace sat {
         if (!should_gc()) return;
         TRACE("sat", tout << m_conflicts_since_gc << " " << m_gc_threshold << "\n";);
         unsigned gc = m_stats.m_gc_clause;
+        unsigned num_learned = m_learned.size();
         m_conflicts_since_gc = 0;
         m_gc_threshold += m_config.m_gc_increment;
         IF_VERBOSE(10, verbose_stream() << "(sat.gc)\n";);
@@ -71,6 +72,8 @@ namespace sat {
             break;
         }
         if (m_ext) m_ext->gc();
+        if (m_event_log) 
+            m_event_log->gc(num_learned, m_learned.size());
         if (gc > 0 && should_defrag()) {
             defrag_clauses();
         }
@@ -0,0 +1,150 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    sat_inprocess.cpp
+
+Abstract:
+
+    Adaptive scheduling of inprocessing techniques.
+
+Revision History:
+
+--*/
+#include "sat/sat_inprocess.h"
+#include "sat/sat_solver.h"
+
+namespace sat {
+
+    struct inprocess_keys {
+        char const* m_name;
+        char const* m_calls;
+        char const* m_skipped;
+        char const* m_productive;
+        char const* m_vars;
+        char const* m_clauses;
+        char const* m_lits;
+        char const* m_bins;
+        char const* m_time;
+    };
+
+#define INPROCESS_KEYS(_name_) { _name_,                                \
+            "sat inprocess " _name_ " calls",                           \
+            "sat inprocess " _name_ " skipped",                         \
+            "sat inprocess " _name_ " productive",                      \
+            "sat inprocess " _name_ " vars removed",                    \
+            "sat inprocess " _name_ " clauses removed",                 \
+            "sat inprocess " _name_ " literals removed",                \
+            "sat inprocess " _name_ " binary clauses",                  \
+            "sat inprocess " _name_ " time" }
+
+    static inprocess_keys const s_keys[inprocess::num_techniques] = {
+        INPROCESS_KEYS("scc"),
+        INPROCESS_KEYS("simplifier"),
+        INPROCESS_KEYS("probing"),
+        INPROCESS_KEYS("asymm-branch"),
+        INPROCESS_KEYS("lookahead"),
+        INPROCESS_KEYS("binspr"),
+        INPROCESS_KEYS("anf"),
+        INPROCESS_KEYS("cut"),
+    };
+
+    inprocess::scoped_run::scoped_run(inprocess& p, technique t):
+        p(p), m_technique(t) {
+        p.get_measure(m_before);
+        m_watch.start();
+    }
+
+    inprocess::scoped_run::~scoped_run() {
+        m_watch.stop();
+        p.update(m_technique, m_before, m_watch.get_seconds());
+    }
+
+    void inprocess::get_measure(measure& m) const {
+        unsigned inactive = s.init_trail_size() + s.num_eliminated();
+        m.m_vars = s.num_vars() > inactive ? s.num_vars() - inactive : 0;
+        m.m_clauses = s.m_clauses.size();
+        m.m_lits = s.m_asymm_branch.num_elim_literals();
+        m.m_bins = s.m_stats.m_mk_bin_clause + s.m_asymm_branch.num_tr();
+    }
+
+    bool inprocess::should_run(technique t) {
+        info& i = m_info[t];
+        if (!s.m_config.m_inprocess_adaptive || i.m_delay == 0)
+            return true;
+        --i.m_delay;
+        ++i.m_skipped;
+        return false;
+    }
+
+    void inprocess::update(technique t, measure const& before, double time) {
+        measure after;
+        get_measure(after);
+        info& i = m_info[t];
+        ++i.m_calls;
+        i.m_time += time;
+        bool productive = s.inconsistent();
+        if (after.m_vars < before.m_vars) {
+            i.m_vars += before.m_vars - after.m_vars;
+            productive = true;
+        }
+        if (after.m_clauses < before.m_clauses) {
+            i.m_clauses += before.m_clauses - after.m_clauses;
+            productive = true;
+        }
+        if (after.m_lits > before.m_lits) {
+            i.m_lits += after.m_lits - before.m_lits;
+            productive = true;
+        }
+        if (after.m_bins > before.m_bins) {
+            i.m_bins += after.m_bins - before.m_bins;
+            productive = true;
+        }
+        if (s.m_event_log)
+            s.m_event_log->inprocess(s_keys[t].m_name, time, 
+                                     before.m_vars > after.m_vars ? before.m_vars - after.m_vars : 0,
+                                     before.m_clauses > after.m_clauses ? before.m_clauses - after.m_clauses : 0);
+        if (productive) {
+            ++i.m_productive;
+            i.m_backoff = 0;
+            i.m_delay = 0;
+        }
+        else {
+            i.m_backoff = std::min(std::max(1u, 2 * i.m_backoff), s.m_config.m_inprocess_max_delay);
+            i.m_delay = i.m_backoff;
+            IF_VERBOSE(3, verbose_stream() << "(sat.inprocess :unproductive " << s_keys[t].m_name 
+                       << " :time " << time << " :delay " << i.m_delay << ")\n";);
+        }
+    }
+
+    void inprocess::collect_statistics(statistics& st) const {
+        for (unsigned t = 0; t < num_techniques; ++t) {
+            info const& i = m_info[t];
+            if (i.m_calls == 0 && i.m_skipped == 0)
+                continue;
+            inprocess_keys const& k = s_keys[t];
+            st.update(k.m_calls, i.m_calls);
+            st.update(k.m_skipped, i.m_skipped);
+            st.update(k.m_productive, i.m_productive);
+            st.update(k.m_vars, i.m_vars);
+            st.update(k.m_clauses, i.m_clauses);
+            st.update(k.m_lits, i.m_lits);
+            st.update(k.m_bins, i.m_bins);
+            st.update(k.m_time, i.m_time);
+        }
+    }
+
+    void inprocess::reset_statistics() {
+        for (info& i : m_info) {
+            i.m_calls = 0;
+            i.m_skipped = 0;
+            i.m_productive = 0;
+            i.m_vars = 0;
+            i.m_clauses = 0;
+            i.m_lits = 0;
+            i.m_bins = 0;
+            i.m_time = 0;
+        }
+    }
+};
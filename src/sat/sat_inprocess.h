@@ -0,0 +1,99 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    sat_inprocess.h
+
+Abstract:
+
+    Adaptive scheduling of inprocessing techniques.
+
+    Each technique applied during simplification is measured by
+    how much it changed the problem: the number of active variables
+    and irredundant clauses with more than two literals it removed,
+    the number of literals asymmetric branching removed from clauses,
+    and the number of binary clauses added, or removed by transitive
+    reduction. All are read from counters of the solver, so measuring
+    a technique does not scan the clauses.
+    A technique that does not reduce the problem is skipped for a
+    number of subsequent simplification rounds. The number of rounds
+    doubles for every unproductive run, up to inprocess.max_delay, and
+    is reset when the technique reduces the problem.
+
+Revision History:
+
+--*/
+#pragma once
+
+#include "util/statistics.h"
+#include "util/stopwatch.h"
+#include "sat/sat_types.h"
+
+namespace sat {
+    class solver;
+
+    class inprocess {
+    public:
+        enum technique {
+            scc_t,
+            simplifier_t,
+            probing_t,
+            asymm_branch_t,
+            lookahead_t,
+            binspr_t,
+            anf_t,
+            cut_t,
+            num_techniques
+        };
+
+    private:
+        struct measure {
+            unsigned m_vars { 0 };
+            unsigned m_clauses { 0 };
+            unsigned m_lits { 0 };  // literals removed so far
+            unsigned m_bins { 0 };  // binary clauses added or removed so far
+        };
+
+        struct info {
+            unsigned m_calls { 0 };
+            unsigned m_skipped { 0 };
+            unsigned m_productive { 0 };
+            unsigned m_vars { 0 };
+            unsigned m_clauses { 0 };
+            unsigned m_lits { 0 };
+            unsigned m_bins { 0 };
+            double   m_time { 0 };
+            unsigned m_delay { 0 };
+            unsigned m_backoff { 0 };
+        };
+
+        solver&  s;
+        info     m_info[num_techniques];
+
+        void get_measure(measure& m) const;
+        void update(technique t, measure const& before, double time);
+
+    public:
+
+        class scoped_run {
+            inprocess& p;
+            technique  m_technique;
+            measure    m_before;
+            stopwatch  m_watch;
+        public:
+            scoped_run(inprocess& p, technique t);
+            ~scoped_run();
+        };
+
+        inprocess(solver& s): s(s) {}
+
+        /**
+           \brief determine whether technique t should be applied in the current simplification round.
+        */
+        bool should_run(technique t);
+
+        void collect_statistics(statistics& st) const;
+        void reset_statistics();
+    };
+};
@@ -140,12 +140,15 @@ namespace sat {
         VERIFY(s.m_phase.size() == s.num_vars());
         VERIFY(s.m_prev_phase.size() == s.num_vars());
         VERIFY(s.m_assigned_since_gc.size() == s.num_vars());
+        unsigned num_eliminated = 0;
         for (bool_var v = 0; v < s.num_vars(); v++) {
             if (s.was_eliminated(v)) {
+                ++num_eliminated;
                 VERIFY(s.get_wlist(literal(v, false)).empty());
                 VERIFY(s.get_wlist(literal(v, true)).empty());
             }
         }
+        VERIFY(num_eliminated == s.num_eliminated());
         return true;
     }
 
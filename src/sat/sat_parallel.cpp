@@ -22,75 +22,76 @@ Revision History:
 
 namespace sat {
 
-    void parallel::vector_pool::next(unsigned& index) {
-        SASSERT(index < m_size);
-        unsigned n = index + 2 + get_length(index);
-        if (n >= m_size) {
-            index = 0;
-        }
-        else {
-            index = n;
-        }
-    }
-
-    void parallel::vector_pool::reserve(unsigned num_threads, unsigned sz) {
-        m_vectors.reset();
-        m_vectors.resize(sz, 0);
-        m_heads.reset();
-        m_heads.resize(num_threads, 0);
-        m_at_end.reset();
-        m_at_end.resize(num_threads, true);
-        m_tail = 0;
-        m_size = sz;
-    }
-    
-    void parallel::vector_pool::begin_add_vector(unsigned owner, unsigned n) {
-        SASSERT(m_tail < m_size);
-        unsigned capacity = n + 2;
-        m_vectors.reserve(m_size + capacity, 0);
-        IF_VERBOSE(3, verbose_stream() << owner << ": begin-add " << n << " tail: " << m_tail << " size: " << m_size << "\n";);
-        for (unsigned i = 0; i < m_heads.size(); ++i) {
-            while (m_tail < m_heads[i] && m_heads[i] < m_tail + capacity) {
-                next(m_heads[i]);
-            }
-            m_at_end[i] = false;
-        }
-        m_vectors[m_tail++] = owner;
-        m_vectors[m_tail++] = n;    
+    parallel::clause_ring::clause_ring(unsigned sz): m_reserved(0), m_published(0) {
+        m_capacity = 16;
+        while (m_capacity < sz) 
+            m_capacity *= 2;
+        m_mask = m_capacity - 1;
+        m_data = alloc_vect<std::atomic<unsigned>>(m_capacity);
     }
 
-    void parallel::vector_pool::add_vector_elem(unsigned e) {
-        m_vectors[m_tail++] = e;
+    parallel::clause_ring::~clause_ring() {
+        dealloc_vect(m_data, m_capacity);
     }
 
-    void parallel::vector_pool::end_add_vector() {
-        if (m_tail >= m_size) {
-            m_tail = 0;
-        }
+    /**
+       \brief append a clause. Only the owning thread calls push.
+       The reserved position is advanced before the clause is written, 
+       such that readers can detect records that get overwritten.
+     */
+    bool parallel::clause_ring::push(unsigned n, literal const* lits) {
+        if (2 * (n + 1) > m_capacity)
+            return false;
+        uint64_t pos = m_reserved.load(std::memory_order_relaxed);
+        uint64_t end = pos + n + 1;
+        m_reserved.store(end, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_data[pos & m_mask].store(n, std::memory_order_relaxed);
+        for (unsigned i = 0; i < n; ++i) 
+            m_data[(pos + i + 1) & m_mask].store(lits[i].index(), std::memory_order_relaxed);
+        m_published.store(end, std::memory_order_release);
+        return true;
     }
 
-
-    bool parallel::vector_pool::get_vector(unsigned owner, unsigned& n, unsigned const*& ptr) {
-        unsigned head = m_heads[owner];      
-        unsigned iterations = 0;
-        while (head != m_tail || !m_at_end[owner]) {
-            ++iterations;
-            SASSERT(head < m_size && m_tail < m_size);            
-            bool is_self = owner == get_owner(head);
-            next(m_heads[owner]);
-            IF_VERBOSE(static_cast<unsigned>(iterations > m_size ? 0 : 3), verbose_stream() << owner << ": [" << head << ":" << m_heads[owner] << "] tail: " << m_tail << "\n";);
-            m_at_end[owner] = (m_heads[owner] == m_tail);
-            if (!is_self) {
-                n = get_length(head);
-                ptr = get_ptr(head);
+    /**
+       \brief retrieve the clause at position pos. 
+       If the reader has fallen behind by more than the capacity of the ring,
+       or the clause was overwritten while it was copied, the reader skips to the 
+       most recently published position.
+     */
+    bool parallel::clause_ring::pop(uint64_t& pos, literal_vector& lits) const {
+        while (true) {
+            uint64_t tail = m_published.load(std::memory_order_acquire);
+            if (pos >= tail)
+                return false;
+            if (tail - pos > m_capacity) {
+                pos = tail;
+                return false;
+            }
+            unsigned n = m_data[pos & m_mask].load(std::memory_order_relaxed);
+            bool valid = 2 * (n + 1) <= m_capacity;
+            lits.reset();
+            for (unsigned i = 0; valid && i < n; ++i) 
+                lits.push_back(to_literal(m_data[(pos + i + 1) & m_mask].load(std::memory_order_relaxed)));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (valid && m_reserved.load(std::memory_order_relaxed) <= pos + m_capacity) {
+                pos += n + 1;
                 return true;
             }
-            head = m_heads[owner];
+            // the record was overwritten while reading it.
+            pos = tail;
         }
-        return false;
     }
 
-    parallel::parallel(solver& s): m_num_clauses(0), m_consumer_ready(false), m_scoped_rlimit(s.rlimit()) {}
+    void parallel::reserve(unsigned num_owners, unsigned sz) {
+        m_rings.reset();
+        for (unsigned i = 0; i < num_owners; ++i)
+            m_rings.push_back(alloc(clause_ring, sz));
+        m_read_pos.reset();
+        m_read_pos.resize(num_owners * num_owners, 0);
+    }
+
+    parallel::parallel(solver& s): m_num_clauses(0), m_consumer_ready(false), m_ls_best_unsat(UINT_MAX), m_ls_best_fresh(false), m_scoped_rlimit(s.rlimit()) {}
 
     parallel::~parallel() {
         for (unsigned i = 0; i < m_solvers.size(); ++i) {            
@@ -147,59 +148,45 @@ namespace sat {
         if (s.get_config().m_num_threads == 1 || s.m_par_syncing_clauses) return;
         flet<bool> _disable_sync_clause(s.m_par_syncing_clauses, true);
         IF_VERBOSE(3, verbose_stream() << s.m_par_id << ": share " <<  l1 << " " << l2 << "\n";);
-        {
-            lock_guard lock(m_mux);
-            m_pool.begin_add_vector(s.m_par_id, 2);
-            m_pool.add_vector_elem(l1.index());
-            m_pool.add_vector_elem(l2.index());            
-            m_pool.end_add_vector();
-        }        
+        literal lits[2] = { l1, l2 };
+        m_rings[s.m_par_id]->push(2, lits);
     }
 
     void parallel::share_clause(solver& s, clause const& c) {        
-        if (s.get_config().m_num_threads == 1 || !enable_add(c) || s.m_par_syncing_clauses) return;
+        if (s.get_config().m_num_threads == 1 || !enable_add(s, c) || s.m_par_syncing_clauses) return;
         flet<bool> _disable_sync_clause(s.m_par_syncing_clauses, true);
-        unsigned n = c.size();
-        unsigned owner = s.m_par_id;
-        IF_VERBOSE(3, verbose_stream() << owner << ": share " <<  c << "\n";);
-        lock_guard lock(m_mux);
-        m_pool.begin_add_vector(owner, n);                
-        for (unsigned i = 0; i < n; ++i) {
-            m_pool.add_vector_elem(c[i].index());
-        }
-        m_pool.end_add_vector();        
+        IF_VERBOSE(3, verbose_stream() << s.m_par_id << ": share " <<  c << "\n";);
+        m_rings[s.m_par_id]->push(c.size(), c.begin());
     }
 
     void parallel::get_clauses(solver& s) {
         if (s.m_par_syncing_clauses) return;
         flet<bool> _disable_sync_clause(s.m_par_syncing_clauses, true);
-        lock_guard lock(m_mux);
-        _get_clauses(s);        
-    }
-
-    void parallel::_get_clauses(solver& s) {
-        unsigned n;
-        unsigned const* ptr;
         unsigned owner = s.m_par_id;
-        while (m_pool.get_vector(owner, n, ptr)) {
-            m_lits.reset();
-            bool usable_clause = true;
-            for (unsigned i = 0; usable_clause && i < n; ++i) {
-                literal lit(to_literal(ptr[i]));                
-                m_lits.push_back(lit);
-                usable_clause = lit.var() <= s.m_par_num_vars && !s.was_eliminated(lit.var());
-            }
-            IF_VERBOSE(3, verbose_stream() << s.m_par_id << ": retrieve " << m_lits << "\n";);
-            SASSERT(n >= 2);
-            if (usable_clause) {
-                s.mk_clause_core(m_lits.size(), m_lits.data(), sat::status::redundant());
+        unsigned num_owners = m_rings.size();
+        literal_vector lits;
+        for (unsigned j = 0; j < num_owners && !s.inconsistent(); ++j) {
+            if (j == owner)
+                continue;
+            uint64_t& pos = m_read_pos[owner * num_owners + j];
+            while (!s.inconsistent() && m_rings[j]->pop(pos, lits)) {
+                bool usable_clause = true;
+                for (unsigned i = 0; usable_clause && i < lits.size(); ++i) {
+                    bool_var v = lits[i].var();
+                    usable_clause = v <= s.m_par_num_vars && !s.was_eliminated(v);
+                }
+                IF_VERBOSE(3, verbose_stream() << owner << ": retrieve " << lits << "\n";);
+                SASSERT(lits.size() >= 2);
+                if (usable_clause) 
+                    s.import_par_clause(lits.size(), lits.data());
             }
-        }        
+        }
     }
 
-    bool parallel::enable_add(clause const& c) const {
+    bool parallel::enable_add(solver const& s, clause const& c) const {
         // plingeling, glucose heuristic:
-        return (c.size() <= 40 && c.glue() <= 8) || c.glue() <= 2;
+        config const& cfg = s.get_config();
+        return (c.size() <= cfg.m_par_max_size && c.glue() <= cfg.m_par_max_glue) || c.glue() <= 2;
     }
 
     void parallel::_from_solver(solver& s) {
@@ -215,6 +202,12 @@ namespace sat {
 
 
     bool parallel::_to_solver(solver& s) {
+        if (m_ls_best_fresh) {
+            // seed the phase cache with the best assignment found by local search.
+            m_ls_best_fresh = false;
+            for (bool_var v = 0; v < m_ls_best_values.size() && v < s.num_vars(); ++v) 
+                s.m_phase[v] = m_ls_best_values[v];
+        }
         if (m_priorities.empty()) {
             return false;
         }
@@ -261,6 +254,33 @@ namespace sat {
         _to_solver(s);               
     }
 
+    bool parallel::exchange_local_search(unsigned& num_unsat, bool_vector& values, unsigned_vector& weights) {
+        lock_guard lock(m_mux);
+        bool improved = false;
+        if (num_unsat < m_ls_best_unsat) {
+            m_ls_best_unsat = num_unsat;
+            m_ls_best_values.reset();
+            m_ls_best_values.append(values);
+            m_ls_best_fresh = true;
+        }
+        else if (m_ls_best_unsat < num_unsat && m_ls_best_values.size() == values.size()) {
+            num_unsat = m_ls_best_unsat;
+            values.reset();
+            values.append(m_ls_best_values);
+            improved = true;
+        }
+        // weights are only comparable between threads that use the same clauses.
+        if (m_ls_weights.size() == weights.size()) {
+            for (unsigned i = 0; i < weights.size(); ++i) 
+                m_ls_weights[i] = weights[i] = (m_ls_weights[i] + weights[i] + 1) / 2;
+        }
+        else {
+            m_ls_weights.reset();
+            m_ls_weights.append(weights);
+        }
+        return improved;
+    }
+
     bool parallel::copy_solver(solver& s) {
         bool copied = false;
         {
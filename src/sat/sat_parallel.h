@@ -24,32 +24,31 @@ Revision History:
 #include "util/rlimit.h"
 #include "util/scoped_ptr_vector.h"
 #include "util/mutex.h"
+#include <atomic>
 
 namespace sat {
 
     class parallel {
 
-        // shared pool of learned clauses.
-        class vector_pool {
-            unsigned_vector m_vectors;
-            unsigned        m_size{ 0 };
-            unsigned        m_tail{ 0 };
-            unsigned_vector m_heads;
-            bool_vector   m_at_end;
-            void next(unsigned& index);
-            unsigned get_owner(unsigned index) const { return m_vectors[index]; }
-            unsigned get_length(unsigned index) const { return m_vectors[index+1]; }
-            unsigned const* get_ptr(unsigned index) const { return m_vectors.data() + index + 2; }
+        // ring of learned clauses published by a single solver thread.
+        // The owner appends clauses without locking. Readers keep their own 
+        // read positions and discard records that were overwritten while 
+        // they were being copied. Positions increase monotonically and are 
+        // reduced modulo the (power of two) capacity when indexing.
+        class clause_ring {
+            std::atomic<unsigned>*   m_data;
+            unsigned                 m_capacity;
+            unsigned                 m_mask;
+            std::atomic<uint64_t>    m_reserved;  // end of the region the owner is writing to
+            std::atomic<uint64_t>    m_published; // end of the region that is readable
         public:
-            void reserve(unsigned num_owners, unsigned sz);
-            void begin_add_vector(unsigned owner, unsigned n);
-            void end_add_vector();
-            void add_vector_elem(unsigned e);
-            bool get_vector(unsigned owner, unsigned& n, unsigned const*& ptr);
+            clause_ring(unsigned sz);
+            ~clause_ring();
+            bool push(unsigned n, literal const* lits);
+            bool pop(uint64_t& pos, literal_vector& lits) const;
         };
 
-        bool enable_add(clause const& c) const;
-        void _get_clauses(solver& s);
+        bool enable_add(solver const& s, clause const& c) const;
         void _from_solver(solver& s);
         bool _to_solver(solver& s);
         bool _from_solver(i_local_search& s);
@@ -58,16 +57,24 @@ namespace sat {
         typedef hashtable<unsigned, u_hash, u_eq> index_set;
         literal_vector m_units;
         index_set      m_unit_set;
-        literal_vector m_lits;
-        vector_pool    m_pool;
         mutex          m_mux;
 
+        // clause sharing, one ring per solver thread
+        scoped_ptr_vector<clause_ring> m_rings;
+        svector<uint64_t>              m_read_pos;  // m_read_pos[consumer * m_rings.size() + producer]
+
         // for exchange with local search:
         unsigned           m_num_clauses;
         scoped_ptr<solver> m_solver_copy;
         bool               m_consumer_ready;
         svector<double>    m_priorities;
 
+        // for exchange between local search threads:
+        unsigned           m_ls_best_unsat;    // fewest unsatisfied clauses reported so far
+        bool_vector        m_ls_best_values;   // assignment with fewest unsatisfied clauses
+        bool               m_ls_best_fresh;    // best assignment was not yet used as phase
+        unsigned_vector    m_ls_weights;       // clause weights averaged over local search threads
+
         scoped_limits      m_scoped_rlimit;
         vector<reslimit>   m_limits;
         ptr_vector<solver> m_solvers;
@@ -83,7 +90,7 @@ namespace sat {
         void push_child(reslimit& rl);
 
         // reserve space
-        void reserve(unsigned num_owners, unsigned sz) { m_pool.reserve(num_owners, sz); }
+        void reserve(unsigned num_owners, unsigned sz);
 
         solver& get_solver(unsigned i) { return *m_solvers[i]; }
 
@@ -106,6 +113,10 @@ namespace sat {
         
         bool from_solver(i_local_search& s);
         void to_solver(i_local_search& s);
+
+        // exchange best assignment and clause weights between local search threads.
+        // returns true if values and num_unsat were replaced by a better assignment.
+        bool exchange_local_search(unsigned& num_unsat, bool_vector& values, unsigned_vector& weights);
         
         bool copy_solver(solver& s);
     };
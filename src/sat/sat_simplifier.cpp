@@ -25,18 +25,38 @@ Revision History:
 #include "sat/sat_integrity_checker.h"
 #include "util/stopwatch.h"
 #include "util/trace.h"
+#ifndef SINGLE_THREAD
+#include <thread>
+#endif
 
 namespace sat {
 
     void use_list::init(unsigned num_vars) {
         m_use_list.reset();
+        m_arena.reset();
         unsigned num_lits = 2 * num_vars;
         m_use_list.resize(num_lits);
     }
 
+    /**
+       \brief count the occurrences of the clauses in cs that are going to be inserted.
+       Use lists are sized in bulk by allocate() after the counts are accumulated.
+    */
+    void use_list::reserve(clause_vector const& cs) {
+        for (clause* c : cs) 
+            if (!c->frozen())
+                for (literal l : *c)
+                    m_use_list[l.index()].reserve_one();
+    }
+
+    void use_list::allocate() {
+        for (auto& ul : m_use_list)
+            ul.allocate(m_arena);
+    }
+
     void use_list::insert(clause & c) {
         for (literal l : c) 
-            m_use_list[l.index()].insert(c);
+            m_use_list[l.index()].insert(c, m_arena);
     }
 
     void use_list::erase(clause & c) {
@@ -205,6 +225,10 @@ namespace sat {
         CASSERT("sat_solver", s.check_invariant());
         m_need_cleanup = false;
         m_use_list.init(s.num_vars());
+        if (learned)
+            m_use_list.reserve(s.m_learned);
+        m_use_list.reserve(s.m_clauses);
+        m_use_list.allocate();
         m_learned_in_use_lists = learned;
         if (learned) {
             register_clauses(s.m_learned);
@@ -1774,6 +1798,101 @@ namespace sat {
             r.push_back(p.first);
     }
 
+    /**
+       \brief Collect irredundant clauses and binary clauses containing l
+       without compressing the use list of l.
+    */
+    void simplifier::collect_irredundant(literal l, clause_wrapper_vector & r) const {
+        for (clause* c : m_use_list.get(l)) 
+            if (!c->is_learned() && !c->was_removed())
+                r.push_back(clause_wrapper(*c));
+        for (auto const& w : get_wlist(~l)) 
+            if (w.is_binary_non_learned_clause())
+                r.push_back(clause_wrapper(l, w.get_literal()));
+    }
+
+    /**
+       \brief check if resolution on v produces more non-tautological resolvents
+       than the clauses it removes. This is the test used by try_eliminate, 
+       but it only reads the use lists and watch lists. 
+    */
+    bool simplifier::exceeds_resolvents(bool_var v, svector<char> & visited, clause_wrapper_vector & pos, clause_wrapper_vector & neg) const {
+        literal pos_l(v, false);
+        literal neg_l(v, true);
+        pos.reset();
+        neg.reset();
+        collect_irredundant(pos_l, pos);
+        collect_irredundant(neg_l, neg);
+        unsigned before = pos.size() + neg.size();
+        unsigned after = 0;
+        for (clause_wrapper const& c1 : pos) {
+            for (literal l1 : c1)
+                visited[l1.index()] = true;
+            for (clause_wrapper const& c2 : neg) {
+                bool is_taut = false;
+                for (literal l2 : c2) {
+                    if (l2 != neg_l && visited[(~l2).index()]) {
+                        is_taut = true;
+                        break;
+                    }
+                }
+                if (!is_taut && ++after > before)
+                    break;
+            }
+            for (literal l1 : c1)
+                visited[l1.index()] = false;
+            if (after > before)
+                return true;
+        }
+        return false;
+    }
+
+    /**
+       \brief score elimination candidates in parallel before they are eliminated sequentially.
+       Candidates that produce too many resolvents are marked as rejected together with 
+       the number of occurrences they had when they were scored.
+    */
+    void simplifier::score_elim_candidates(bool_var_vector const & vars, svector<elim_score> & scores) const {
+        scores.reset();
+#ifndef SINGLE_THREAD
+        unsigned num_threads = m_elim_vars_threads;
+        if (num_threads <= 1 || vars.size() < 1000)
+            return;
+        scores.resize(vars.size());
+        auto score = [&](unsigned id) {
+            svector<char> visited(2 * s.num_vars(), (char)0);
+            clause_wrapper_vector pos, neg;
+            for (unsigned i = id; i < vars.size(); i += num_threads) {
+                bool_var v = vars[i];
+                literal pos_l(v, false);
+                literal neg_l(v, true);
+                elim_score& sc = scores[i];
+                sc.m_num_pos = m_use_list.get(pos_l).size() + num_nonlearned_bin(pos_l);
+                sc.m_num_neg = m_use_list.get(neg_l).size() + num_nonlearned_bin(neg_l);
+                sc.m_rejected = exceeds_resolvents(v, visited, pos, neg);
+            }
+        };
+        vector<std::thread> threads;
+        for (unsigned id = 0; id < num_threads; ++id)
+            threads.push_back(std::thread([&, id]() { score(id); }));
+        for (auto& th : threads)
+            th.join();
+#endif
+    }
+
+    /**
+       \brief a rejected candidate remains rejected if its occurrences did not change since it was scored.
+    */
+    bool simplifier::is_rejected(bool_var v, elim_score const & sc) const {
+        if (!sc.m_rejected || m_elim_todo.contains(v))
+            return false;
+        literal pos_l(v, false);
+        literal neg_l(v, true);
+        return 
+            sc.m_num_pos == m_use_list.get(pos_l).size() + num_nonlearned_bin(pos_l) &&
+            sc.m_num_neg == m_use_list.get(neg_l).size() + num_nonlearned_bin(neg_l);
+    }
+
     /**
        \brief Collect clauses and binary clauses containing l.
     */
@@ -2023,8 +2142,8 @@ namespace sat {
         remove_bin_clauses(neg_l);
         remove_clauses(pos_occs, pos_l);
         remove_clauses(neg_occs, neg_l);
-        pos_occs.reset();
-        neg_occs.reset();
+        m_use_list.reset(pos_l);
+        m_use_list.reset(neg_l);
         return true;
     }
 
@@ -2054,14 +2173,22 @@ namespace sat {
         elim_var_report rpt(*this);
         bool_var_vector vars;
         order_vars_for_elim(vars);
+        svector<elim_score> scores;
+        score_elim_candidates(vars, scores);
         sat::elim_vars elim_bdd(*this);
-        for (bool_var v : vars) {
+        for (unsigned i = 0; i < vars.size(); ++i) {
+            bool_var v = vars[i];
             checkpoint();
             if (m_elim_counter < 0) 
                 break;
             if (is_external(v)) {
                 // skip
             }
+            else if (!scores.empty() && is_rejected(v, scores[i])) {
+                m_num_elim_skipped++;
+                if (elim_vars_bdd_enabled() && elim_bdd(v))
+                    m_num_elim_vars++;
+            }
             else if (try_eliminate(v)) {
                 m_num_elim_vars++;
             }
@@ -2102,6 +2229,7 @@ namespace sat {
         m_elim_vars               = p.elim_vars();
         m_elim_vars_bdd           = false && p.elim_vars_bdd(); // buggy?
         m_elim_vars_bdd_delay     = p.elim_vars_bdd_delay();
+        m_elim_vars_threads       = p.elim_vars_threads();
         m_incremental_mode        = s.get_config().m_incremental && !p.override_incremental();
     }
 
@@ -2119,6 +2247,7 @@ namespace sat {
         st.update("sat abce", m_num_abce);
         st.update("sat bca",  m_num_bca);
         st.update("sat ate",  m_num_ate);
+        st.update("sat elim vars skipped", m_num_elim_skipped);
     }
 
     void simplifier::reset_statistics() {
@@ -2132,5 +2261,6 @@ namespace sat {
         m_num_elim_vars = 0;
         m_num_bca = 0;
         m_num_ate = 0;
+        m_num_elim_skipped = 0;
     }
 };
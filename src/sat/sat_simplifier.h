@@ -40,8 +40,11 @@ namespace sat {
 
     class use_list {
         vector<clause_use_list> m_use_list;
+        clause_arena            m_arena;
     public:
         void init(unsigned num_vars);
+        void reserve(clause_vector const& cs);
+        void allocate();
         void insert(clause & c);
         void block(clause & c);
         void unblock(clause & c);
@@ -49,7 +52,8 @@ namespace sat {
         void erase(clause & c, literal l);
         clause_use_list & get(literal l) { return m_use_list[l.index()]; }
         clause_use_list const & get(literal l) const { return m_use_list[l.index()]; }
-        void finalize() { m_use_list.finalize(); }
+        void reset(literal l) { m_use_list[l.index()].reset(m_arena); }
+        void finalize() { m_use_list.finalize(); m_arena.reset(); }
         std::ostream& display(std::ostream& out, literal l) const { return m_use_list[l.index()].display(out); }
     };
 
@@ -103,6 +107,7 @@ namespace sat {
         bool                   m_elim_vars;
         bool                   m_elim_vars_bdd;
         unsigned               m_elim_vars_bdd_delay;
+        unsigned               m_elim_vars_threads;
 
         // stats
         unsigned               m_num_bce;
@@ -115,6 +120,7 @@ namespace sat {
         unsigned               m_num_elim_vars;
         unsigned               m_num_sub_res;
         unsigned               m_num_elim_lits;
+        unsigned               m_num_elim_skipped;
 
         bool                   m_learned_in_use_lists;
         unsigned               m_old_num_elim_vars;
@@ -192,6 +198,17 @@ namespace sat {
         unsigned num_nonlearned_bin(literal l) const;
         unsigned get_to_elim_cost(bool_var v) const;
         void order_vars_for_elim(bool_var_vector & r);
+
+        // result of scoring an elimination candidate in parallel
+        struct elim_score {
+            unsigned m_num_pos { 0 };
+            unsigned m_num_neg { 0 };
+            bool     m_rejected { false };
+        };
+        void collect_irredundant(literal l, clause_wrapper_vector & r) const;
+        bool exceeds_resolvents(bool_var v, svector<char> & visited, clause_wrapper_vector & pos, clause_wrapper_vector & neg) const;
+        void score_elim_candidates(bool_var_vector const & vars, svector<elim_score> & scores) const;
+        bool is_rejected(bool_var v, elim_score const & sc) const;
         void collect_clauses(literal l, clause_wrapper_vector & r);
         clause_wrapper_vector m_pos_cls;
         clause_wrapper_vector m_neg_cls;
@@ -33,6 +33,7 @@ Revision History:
 #include "sat/sat_prob.h"
 #include "sat/sat_anf_simplifier.h"
 #include "sat/sat_cut_simplifier.h"
+#include "sat/sat_cube_and_conquer.h"
 #if defined(_MSC_VER) && !defined(_M_ARM) && !defined(_M_ARM64)
 # include <xmmintrin.h>
 #endif
@@ -56,6 +57,7 @@ namespace sat {
         m_probing(*this, p),
         m_mus(*this),
         m_binspr(*this),
+        m_inprocess(*this),
         m_inconsistent(false),
         m_searching(false),
         m_conflict(justification(0)),
@@ -72,6 +74,7 @@ namespace sat {
         m_trail_avg(),
         m_params(p),
         m_par_id(0),
+        m_par_next_import(0),
         m_par_syncing_clauses(false) {
         init_reason_unknown();
         updt_params(p);
@@ -127,6 +130,7 @@ namespace sat {
         m_justification.reset();
         m_decision.reset();
         m_eliminated.reset();
+        m_num_eliminated = 0;
         m_external.reset();
         m_var_scope.reset();
         m_activity.reset();
@@ -257,6 +261,8 @@ namespace sat {
         m_assignment[2*v+1] = l_undef;
         m_justification[v] = justification(UINT_MAX);
         m_decision[v] = dvar;
+        if (m_eliminated[v])
+            --m_num_eliminated;
         m_eliminated[v] = false;
         m_external[v] = ext;
         m_var_scope[v] = scope_lvl();
@@ -334,6 +340,8 @@ namespace sat {
             reset_var(v, m_external[v], m_decision[v]);
         else if (f && m_ext)
             m_ext->set_eliminated(v);
+        if (f)
+            ++m_num_eliminated;
         m_eliminated[v] = f; 
     }
 
@@ -1147,7 +1155,17 @@ namespace sat {
                 unsigned assign_level = curr_level;
                 unsigned max_index = 1;
                 for (; l_it != l_end; ++l_it) {
-                    if (value(*l_it) != l_false) {
+                    lbool val = value(*l_it);
+                    if (val == l_true && lvl(*l_it) <= curr_level) {
+                        // the clause is satisfied by a literal that is retracted no earlier than not_l.
+                        // keep the watch and use the literal as blocker, this avoids moving the watch
+                        // and the next visit can skip the clause without touching it.
+                        m_stats.m_blocker_update++;
+                        it2->set_clause(*l_it, cls_off);
+                        it2++;
+                        goto end_clause_case;
+                    }
+                    if (val != l_false) {
                         c[1] = *l_it;
                         *l_it = not_l;
                         DEBUG_CODE(for (auto const& w : m_watches[(~c[1]).index()]) VERIFY(!w.is_clause() || w.get_clause_offset() != cls_off););
@@ -1283,6 +1301,11 @@ namespace sat {
         IF_VERBOSE(2, verbose_stream() << "(sat.solver)\n";);
         SASSERT(at_base_lvl());
 
+        if (!m_event_log && !m_par && m_config.m_events_file.is_non_empty_string()) 
+            m_event_log = alloc(event_log, *this, m_config.m_events_file, m_config.m_events_json, 
+                                m_config.m_events_buffer_size, m_config.m_events_interval);
+        scoped_event_log_flush _flush_events(m_event_log.get());
+
         if (m_config.m_ddfw_search) {
             m_cleaner(true);
             return do_ddfw_search(num_lits, lits);
@@ -1295,6 +1318,14 @@ namespace sat {
             m_cleaner(true);
             return do_local_search(num_lits, lits);
         }
+#ifndef SINGLE_THREAD
+        // without threads cube and conquer falls back to sequential search.
+        if (m_config.m_cube_and_conquer && !m_par && !m_ext && !m_config.m_drat) {
+            SASSERT(scope_lvl() == 0);
+            cube_and_conquer cc(*this);
+            return cc(num_lits, lits);
+        }
+#endif
         if ((m_config.m_num_threads > 1 || m_config.m_local_search_threads > 0 || 
              m_config.m_ddfw_threads > 0) && !m_par && !m_ext) {
             SASSERT(scope_lvl() == 0);
@@ -1363,6 +1394,9 @@ namespace sat {
         if (limit_reached() || memory_exceeded()) {
             return true;
         }
+        if (m_config.m_drat) {
+            m_drat.check_output();
+        }
         if (m_config.m_restart_max <= m_restarts) {
             m_reason_unknown = "sat.max.restarts";
             IF_VERBOSE(SAT_VB_LVL, verbose_stream() << "(sat \"abort: max-restarts\")\n";);
@@ -1474,7 +1508,7 @@ namespace sat {
 #define IS_MAIN_SOLVER(i)  (i == main_solver_offset)
 
         sat::parallel par(*this);
-        par.reserve(num_threads, 1 << 12);
+        par.reserve(num_threads, m_config.m_par_buffer_size);
         par.init_solvers(*this, num_extra_solvers);
         for (unsigned i = 0; i < ls.size(); ++i) {
             par.push_child(ls[i]->rlimit());
@@ -1591,6 +1625,11 @@ namespace sat {
       \brief import lemmas/units from parallel sat solvers.
      */
     void solver::exchange_par() {
+        if (m_par && at_base_lvl()) {
+            for (unsigned i = 0; !inconsistent() && i < m_par_units.size(); ++i)
+                assign_unit(m_par_units[i]);
+            m_par_units.reset();
+        }
         if (m_par && at_base_lvl() && m_config.m_num_threads > 1) m_par->get_clauses(*this);
         if (m_par && at_base_lvl() && m_config.m_num_threads > 1) {
             // SASSERT(scope_lvl() == search_lvl());
@@ -1627,7 +1666,73 @@ namespace sat {
         m_par_limit_in = 0;
         m_par_limit_out = 0;
         m_par_id = id; 
+        m_par_next_import = 0;
         m_par_syncing_clauses = false;
+        m_par_units.reset();
+    }
+
+    /*
+      \brief import lemmas from parallel sat solvers during search, 
+      without waiting for the next restart.
+     */
+    bool solver::should_import_par() const {
+        return 
+            m_par && 
+            m_config.m_num_threads > 1 && 
+            m_config.m_par_import_interval > 0 &&
+            m_conflicts_since_init >= m_par_next_import;
+    }
+
+    void solver::import_par() {
+        m_par_next_import = m_conflicts_since_init + m_config.m_par_import_interval;
+        m_par->get_clauses(*this);
+    }
+
+    /*
+      \brief add a clause learned by another solver.
+      Above the base level the clause is not asserting, so it is simplified 
+      with respect to level 0 and attached as a regular clause that may propagate 
+      or produce a conflict at a lower level. Units found above the base level
+      are assigned when the solver is back at the base level.
+     */
+    void solver::import_par_clause(unsigned num_lits, literal* lits) {
+        if (!simplify_clause(num_lits, lits))
+            return;
+        switch (num_lits) {
+        case 0:
+            set_conflict();
+            break;
+        case 1:
+            // the other literals are false at level 0, so lits[0] is a unit.
+            if (m_config.m_drat)
+                drat_log_clause(num_lits, lits, sat::status::redundant());
+            if (at_base_lvl())
+                assign_unit(lits[0]);
+            else
+                m_par_units.push_back(lits[0]);
+            break;
+        case 2:
+            mk_bin_clause(lits[0], lits[1], sat::status::redundant());
+            break;
+        case 3:
+            if (ENABLE_TERNARY) {
+                mk_ter_clause(lits, sat::status::redundant());
+                break;
+            }
+            Z3_fallthrough;
+        default: {
+            m_stats.m_mk_clause++;
+            clause * r = alloc_clause(num_lits, lits, true);
+            bool reinit = attach_nary_clause(*r, false);
+            if (reinit || has_variables_to_reinit(*r)) push_reinit_stack(*r);
+            m_learned.push_back(r);
+            if (m_config.m_drat)
+                m_drat.add(*r, sat::status::redundant());
+            for (literal l : *r) 
+                m_touched[l.var()] = m_touch_index;
+            break;
+        }
+        }
     }
 
     bool_var solver::next_var() {
@@ -1719,6 +1824,7 @@ namespace sat {
         while (is_sat == l_undef && !should_cancel()) {
             if (inconsistent()) is_sat = resolve_conflict_core();
             else if (should_propagate()) propagate(true);
+            else if (should_import_par()) import_par();
             else if (do_cleanup(false)) continue;
             else if (should_gc()) do_gc();
             else if (should_rephase()) do_rephase();
@@ -1987,6 +2093,8 @@ namespace sat {
             ~report() { 
                 m_watch.stop(); 
                 s.log_stats();
+                if (s.m_event_log) 
+                    s.m_event_log->simplify(m_watch.get_seconds());
             }
         };
         report _rprt(*this);
@@ -1995,29 +2103,41 @@ namespace sat {
         m_cleaner(m_config.m_force_cleanup);
         CASSERT("sat_simplify_bug", check_invariant());
 
-        m_scc();
+        if (m_inprocess.should_run(inprocess::scc_t)) {
+            inprocess::scoped_run _run(m_inprocess, inprocess::scc_t);
+            m_scc();
+        }
         CASSERT("sat_simplify_bug", check_invariant());
 
         if (m_ext) {
             m_ext->pre_simplify();
         }
       
-        m_simplifier(false);
+        if (m_inprocess.should_run(inprocess::simplifier_t)) {
+            inprocess::scoped_run _run(m_inprocess, inprocess::simplifier_t);
+            m_simplifier(false);
 
-        CASSERT("sat_simplify_bug", check_invariant());
-        CASSERT("sat_missed_prop", check_missed_propagation());
-        if (!m_learned.empty()) {
-            m_simplifier(true);
-            CASSERT("sat_missed_prop", check_missed_propagation());
             CASSERT("sat_simplify_bug", check_invariant());
+            CASSERT("sat_missed_prop", check_missed_propagation());
+            if (!m_learned.empty()) {
+                m_simplifier(true);
+                CASSERT("sat_missed_prop", check_missed_propagation());
+                CASSERT("sat_simplify_bug", check_invariant());
+            }
         }
         sort_watch_lits();
         CASSERT("sat_simplify_bug", check_invariant());
 
-        m_probing();
+        if (m_inprocess.should_run(inprocess::probing_t)) {
+            inprocess::scoped_run _run(m_inprocess, inprocess::probing_t);
+            m_probing();
+        }
         CASSERT("sat_missed_prop", check_missed_propagation());
         CASSERT("sat_simplify_bug", check_invariant());
-        m_asymm_branch(false);
+        if (m_inprocess.should_run(inprocess::asymm_branch_t)) {
+            inprocess::scoped_run _run(m_inprocess, inprocess::asymm_branch_t);
+            m_asymm_branch(false);
+        }
 
         CASSERT("sat_missed_prop", check_missed_propagation());
         CASSERT("sat_simplify_bug", check_invariant());
@@ -2025,7 +2145,8 @@ namespace sat {
             m_ext->clauses_modifed();
             m_ext->simplify();
         }
-        if (m_config.m_lookahead_simplify && !m_ext) {
+        if (m_config.m_lookahead_simplify && !m_ext && m_inprocess.should_run(inprocess::lookahead_t)) {
+            inprocess::scoped_run _run(m_inprocess, inprocess::lookahead_t);
             lookahead lh(*this);
             lh.simplify(true);
             lh.collect_statistics(m_aux_stats);
@@ -2050,20 +2171,24 @@ namespace sat {
             }
         }
 
-        if (m_config.m_binspr && !inconsistent()) {
+        if (m_config.m_binspr && !inconsistent() && m_inprocess.should_run(inprocess::binspr_t)) {
+            inprocess::scoped_run _run(m_inprocess, inprocess::binspr_t);
             m_binspr();
         }
 
-        if (m_config.m_anf_simplify && m_simplifications > m_config.m_anf_delay && !inconsistent()) {
+        if (m_config.m_anf_simplify && m_simplifications > m_config.m_anf_delay && !inconsistent() && 
+            m_inprocess.should_run(inprocess::anf_t)) {
+            inprocess::scoped_run _run(m_inprocess, inprocess::anf_t);
             anf_simplifier anf(*this);
             anf_simplifier::config cfg;
             cfg.m_enable_exlin = m_config.m_anf_exlin;
             anf();
             anf.collect_statistics(m_aux_stats);
-            // TBD: throttle anf_delay based on yield
         }
         
-        if (m_cut_simplifier && m_simplifications > m_config.m_cut_delay && !inconsistent()) {
+        if (m_cut_simplifier && m_simplifications > m_config.m_cut_delay && !inconsistent() && 
+            m_inprocess.should_run(inprocess::cut_t)) {
+            inprocess::scoped_run _run(m_inprocess, inprocess::cut_t);
             (*m_cut_simplifier)();
         }
 
@@ -2295,6 +2420,8 @@ namespace sat {
     void solver::do_restart(bool to_base) {        
         m_stats.m_restart++;
         m_restarts++;
+        if (m_event_log) 
+            m_event_log->restart();
         if (m_conflicts_since_init >= m_restart_next_out && get_verbosity_level() >= 1) {
             if (0 == m_restart_next_out) {
                 m_restart_next_out = 1;
@@ -2391,6 +2518,8 @@ namespace sat {
         m_conflicts_since_restart++;
         m_conflicts_since_gc++;
         m_stats.m_conflict++;
+        if (m_event_log)
+            m_event_log->conflict();
         if (m_step_size > m_config.m_step_size_min) {
             m_step_size -= m_config.m_step_size_dec;
         }
@@ -2595,6 +2724,8 @@ namespace sat {
         unsigned glue = num_diff_levels(m_lemma.size(), m_lemma.data());        
         m_fast_glue_avg.update(glue);
         m_slow_glue_avg.update(glue);
+        if (m_event_log) 
+            m_event_log->learned(glue);
     
         // compute whether to use backtracking or backjumping
         unsigned num_scopes = m_scope_lvl - backjump_lvl;
@@ -3582,6 +3713,9 @@ namespace sat {
         m_assignment.shrink(2*v);
         m_justification.shrink(v);
         m_decision.shrink(v);
+        for (bool_var w = v; w < m_eliminated.size(); ++w)
+            if (m_eliminated[w])
+                --m_num_eliminated;
         m_eliminated.shrink(v);
         m_external.shrink(v);
         m_var_scope.shrink(v);
@@ -3772,6 +3906,7 @@ namespace sat {
         m_scc.collect_statistics(st);
         m_asymm_branch.collect_statistics(st);
         m_probing.collect_statistics(st);
+        m_inprocess.collect_statistics(st);
         if (m_ext) m_ext->collect_statistics(st);
         if (m_local_search) m_local_search->collect_statistics(st);
         if (m_cut_simplifier) m_cut_simplifier->collect_statistics(st);
@@ -3784,6 +3919,7 @@ namespace sat {
         m_simplifier.reset_statistics();
         m_asymm_branch.reset_statistics();
         m_probing.reset_statistics();
+        m_inprocess.reset_statistics();
         m_aux_stats.reset();
     }
 
@@ -4755,6 +4891,7 @@ namespace sat {
         st.update("sat propagations 2ary", m_bin_propagate);
         st.update("sat propagations 3ary", m_ter_propagate);
         st.update("sat propagations nary", m_propagate);
+        st.update("sat blocker updates", m_blocker_update);
         st.update("sat restarts", m_restart);
         st.update("sat minimized lits", m_minimized_lits);
         st.update("sat subs resolution dyn", m_dyn_sub_res);
@@ -42,6 +42,8 @@ Revision History:
 #include "sat/sat_probing.h"
 #include "sat/sat_mus.h"
 #include "sat/sat_binspr.h"
+#include "sat/sat_inprocess.h"
+#include "sat/sat_event_log.h"
 #include "sat/sat_drat.h"
 #include "sat/sat_parallel.h"
 #include "sat/sat_local_search.h"
@@ -65,6 +67,7 @@ namespace sat {
         unsigned m_propagate;
         unsigned m_bin_propagate;
         unsigned m_ter_propagate;
+        unsigned m_blocker_update;
         unsigned m_decision;
         unsigned m_restart;
         unsigned m_gc_clause;
@@ -94,6 +97,7 @@ namespace sat {
         stats                   m_stats;
         scoped_ptr<extension>   m_ext;
         scoped_ptr<cut_simplifier> m_cut_simplifier;
+        scoped_ptr<event_log>   m_event_log;
         parallel*               m_par;
         drat                    m_drat;          // DRAT for generating proofs
         clause_allocator        m_cls_allocator[2];
@@ -110,6 +114,7 @@ namespace sat {
         bool                    m_is_probing { false };
         mus                     m_mus;           // MUS for minimal core extraction
         binspr                  m_binspr;
+        inprocess               m_inprocess;
         bool                    m_inconsistent;
         bool                    m_searching;
         // A conflict is usually a single justification. That is, a justification
@@ -128,6 +133,7 @@ namespace sat {
         bool_vector             m_mark;
         bool_vector             m_lit_mark;
         bool_vector             m_eliminated;
+        unsigned                m_num_eliminated { 0 }; // number of variables set in m_eliminated
         bool_vector             m_external;
         unsigned_vector         m_var_scope;
         unsigned_vector         m_touched;
@@ -193,7 +199,9 @@ namespace sat {
         unsigned                m_par_limit_in;
         unsigned                m_par_limit_out;
         unsigned                m_par_num_vars;
+        unsigned                m_par_next_import;
         bool                    m_par_syncing_clauses;
+        literal_vector          m_par_units;     // units imported above the base level
 
         class lookahead*        m_cuber;
         class i_local_search*   m_local_search;
@@ -207,6 +215,8 @@ namespace sat {
         friend class asymm_branch;
         friend class big;
         friend class binspr;
+        friend class inprocess;
+        friend class event_log;
         friend class drat;
         friend class elim_eqs;
         friend class bcd;
@@ -218,6 +228,7 @@ namespace sat {
         friend class anf_simplifier;
         friend class cut_simplifier;
         friend class parallel;
+        friend class cube_and_conquer;
         friend class lookahead;
         friend class local_search;
         friend class ddfw;
@@ -357,6 +368,7 @@ namespace sat {
         bool was_eliminated(bool_var v) const { return m_eliminated[v]; }
         void set_eliminated(bool_var v, bool f) override;
         bool was_eliminated(literal l) const { return was_eliminated(l.var()); }
+        unsigned num_eliminated() const { return m_num_eliminated; }
         void set_phase(literal l) override { if (l.var() < num_vars()) m_best_phase[l.var()] = m_phase[l.var()] = !l.sign(); }
         bool_var get_phase(bool_var b) { return m_phase.get(b, false); }
         void move_to_front(bool_var b);
@@ -542,6 +554,9 @@ namespace sat {
         bool reached_max_conflicts();
         void sort_watch_lits();
         void exchange_par();
+        bool should_import_par() const;
+        void import_par();
+        void import_par_clause(unsigned num_lits, literal* lits);
         lbool check_par(unsigned num_lits, literal const* lits);
         lbool do_local_search(unsigned num_lits, literal const* lits);
         lbool do_ddfw_search(unsigned num_lits, literal const* lits);
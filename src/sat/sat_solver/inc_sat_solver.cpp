@@ -83,6 +83,20 @@ class inc_sat_solver : public solver {
 
     dep2asm_t          m_dep2asm;
 
+    // assumptions are re-used across calls to check_sat.
+    // m_asm2lit retains the literal that goal2sat produced for literal assumptions and 
+    // m_asm2proxy the proxy constant introduced for other assumptions. 
+    // m_cores retains cores over assumption literals. None of them depend on 
+    // formulas added later, so they are valid until the next pop.
+    obj_map<expr, sat::literal> m_asm2lit;
+    obj_map<expr, expr*>        m_asm2proxy;
+    expr_ref_vector             m_asm_trail;
+    vector<sat::literal_vector> m_cores;
+    unsigned                    m_cores_head;
+    unsigned                    m_core_cache_size;
+    unsigned                    m_num_asm_reused;
+    unsigned                    m_num_core_reused;
+
     bool is_internalized() const { return m_fmls_head == m_fmls.size(); }
 public:
     inc_sat_solver(ast_manager& m, params_ref const& p, bool incremental_mode):
@@ -98,7 +112,12 @@ public:
         m_num_scopes(0),
         m_unknown("no reason given"),
         m_internalized_converted(false), 
-        m_internalized_fmls(m) {
+        m_internalized_fmls(m),
+        m_asm_trail(m),
+        m_cores_head(0),
+        m_core_cache_size(0),
+        m_num_asm_reused(0),
+        m_num_core_reused(0) {
         updt_params(p);
         m_mcs.push_back(nullptr);
         init_preprocess();
@@ -187,12 +206,20 @@ public:
         expr_ref_vector _assumptions(m);
         obj_map<expr, expr*> asm2fml;
         for (unsigned i = 0; i < sz; ++i) {
-            if (!is_literal(assumptions[i])) {
+            expr* p = nullptr;
+            if (!is_literal(assumptions[i]) && m_asm2proxy.find(assumptions[i], p)) {
+                _assumptions.push_back(p);
+                asm2fml.insert(p, assumptions[i]);
+            }
+            else if (!is_literal(assumptions[i])) {
                 expr_ref a(m.mk_fresh_const("s", m.mk_bool_sort()), m);
                 expr_ref fml(m.mk_eq(a, assumptions[i]), m);
                 assert_expr(fml);
                 _assumptions.push_back(a);
                 asm2fml.insert(a, assumptions[i]);
+                m_asm_trail.push_back(a);
+                m_asm_trail.push_back(assumptions[i]);
+                m_asm2proxy.insert(assumptions[i], a);
             }
             else {
                 _assumptions.push_back(assumptions[i]);
@@ -209,6 +236,8 @@ public:
 
         init_reason_unknown();
         m_internalized_converted = false;
+        if (find_cached_core(asm2fml)) 
+            return l_false;
         bool reason_set = false;
         try {
             // IF_VERBOSE(0, m_solver.display(verbose_stream()));
@@ -235,7 +264,8 @@ public:
         case l_false:
             // TBD: expr_dependency core is not accounted for.
             if (!m_asms.empty()) {
-                extract_core(asm2fml);
+                extract_core(m_solver.get_core(), asm2fml);
+                cache_core(m_solver.get_core());
             }
             break;
         default:
@@ -277,6 +307,7 @@ public:
         }
         if (m_bb_rewriter) m_bb_rewriter->pop(n);
         m_inserted_const2bits.reset();
+        reset_assumption_cache();
         m_map.pop(n);
         SASSERT(n <= m_num_scopes);
         m_solver.user_pop(n);
@@ -368,12 +399,19 @@ public:
         m_params.set_sym("pb.solver", p1.pb_solver());
         m_solver.updt_params(m_params);
         m_solver.set_incremental(is_incremental() && !override_incremental());
+        m_core_cache_size = p1.core_cache();
+        if (m_cores.size() > m_core_cache_size) {
+            m_cores.reset();
+            m_cores_head = 0;
+        }
         if (p1.euf() && !get_euf()) 
             ensure_euf();        
     }
     void collect_statistics(statistics & st) const override {
         if (m_preprocess) m_preprocess->collect_statistics(st);
         m_solver.collect_statistics(st);
+        st.update("sat assumptions reused", m_num_asm_reused);
+        st.update("sat cores reused", m_num_core_reused);
     }
     void get_unsat_core(expr_ref_vector & r) override {
         r.reset();
@@ -480,7 +518,7 @@ public:
         r = m_solver.get_consequences(m_asms, bvars, lconseq);
         if (r == l_false) {
             if (!m_asms.empty()) {
-                extract_core(asm2fml);
+                extract_core(m_solver.get_core(), asm2fml);
             }
             return r;
         }
@@ -757,19 +795,102 @@ private:
             return l_true;
         }
         goal_ref g = alloc(goal, m, true, true); // models and cores are enabled.
-        for (unsigned i = 0; i < sz; ++i) {
-            g->assert_expr(asms[i], m.mk_leaf(asms[i]));
-        }
-        for (unsigned i = 0; i < get_num_assumptions(); ++i) {
-            g->assert_expr(get_assumption(i), m.mk_leaf(get_assumption(i)));
-        }
-        lbool res = internalize_goal(g);
+        ptr_vector<expr> fresh;
+        auto add_assumption = [&](expr* a) {
+            if (find_cached_assumption(a)) 
+                ++m_num_asm_reused;
+            else {
+                g->assert_expr(a, m.mk_leaf(a));
+                fresh.push_back(a);
+            }
+        };
+        for (unsigned i = 0; i < sz; ++i) 
+            add_assumption(asms[i]);
+        for (unsigned i = 0; i < get_num_assumptions(); ++i) 
+            add_assumption(get_assumption(i));
+        lbool res = l_true;
+        if (!fresh.empty()) 
+            res = internalize_goal(g);
         if (res == l_true) {
+            for (expr* a : fresh)
+                cache_assumption(a);
             extract_assumptions(sz, asms);
         }
         return res;
     }
 
+    /**
+       \brief retrieve the literal of an assumption that was internalized by a previous call.
+       The literal is only re-used if the atom is still mapped to the same variable.
+    */
+    bool find_cached_assumption(expr* a) {
+        sat::literal lit;
+        if (!m_asm2lit.find(a, lit))
+            return false;
+        expr* atom = a;
+        m.is_not(a, atom);
+        if (m_map.to_bool_var(atom) != lit.var() || lit.var() >= m_solver.num_vars())
+            return false;
+        if (!m_dep2asm.contains(a))
+            m_dep2asm.insert(a, lit);
+        return true;
+    }
+
+    void cache_assumption(expr* a) {
+        sat::literal lit;
+        if (is_literal(a) && m_dep2asm.find(a, lit) && !m_asm2lit.contains(a)) {
+            m_asm_trail.push_back(a);
+            m_asm2lit.insert(a, lit);
+        }
+    }
+
+    /**
+       \brief check if a core from a previous call is contained in the current assumptions.
+       Adding formulas preserves unsatisfiability, so the core remains valid until the next pop.
+    */
+    bool find_cached_core(obj_map<expr, expr*> const& asm2fml) {
+        if (m_cores.empty() || m_asms.empty())
+            return false;
+        sat::literal_set asms;
+        for (sat::literal lit : m_asms)
+            asms.insert(lit);
+        for (sat::literal_vector const& core : m_cores) {
+            bool contained = true;
+            for (sat::literal lit : core) {
+                if (!asms.contains(lit)) {
+                    contained = false;
+                    break;
+                }
+            }
+            if (contained) {
+                TRACE("sat", tout << "reuse core " << core << "\n";);
+                ++m_num_core_reused;
+                extract_core(core, asm2fml);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void cache_core(sat::literal_vector const& core) {
+        if (m_core_cache_size == 0)
+            return;
+        if (m_cores.size() < m_core_cache_size) 
+            m_cores.push_back(core);
+        else {
+            m_cores[m_cores_head] = core;
+            m_cores_head = (m_cores_head + 1) % m_core_cache_size;
+        }
+    }
+
+    void reset_assumption_cache() {
+        m_asm2lit.reset();
+        m_asm2proxy.reset();
+        m_asm_trail.reset();
+        m_cores.reset();
+        m_cores_head = 0;
+    }
+
     lbool internalize_vars(expr_ref_vector const& vars, sat::bool_var_vector& bvars) {
         for (expr* v : vars) {
             internalize_var(v, bvars);
@@ -953,10 +1074,9 @@ private:
         }
     }
 
-    void extract_core(obj_map<expr, expr*> const& asm2fml) {
+    void extract_core(sat::literal_vector const& core, obj_map<expr, expr*> const& asm2fml) {
         u_map<expr*> asm2dep;
         extract_asm2dep(asm2dep);
-        sat::literal_vector const& core = m_solver.get_core();
         TRACE("sat",
               for (auto kv : m_dep2asm) {
                   tout << mk_pp(kv.m_key, m) << " |-> " << sat::literal(kv.m_value) << "\n";
@@ -22,6 +22,8 @@ Revision History:
 #include "util/timeout.h"
 #include "util/rlimit.h"
 #include "util/gparams.h"
+#include "util/mapped_file.h"
+#include "util/stopwatch.h"
 #include "sat/dimacs.h"
 #include "sat/sat_params.hpp"
 #include "sat/sat_solver.h"
@@ -36,6 +38,7 @@ static sat::solver * g_solver = nullptr;
 static clock_t       g_start_time;
 static tactic_ref    g_tac;
 static statistics    g_st;
+static double        g_load_time = 0;
 
 static void display_statistics() {
     clock_t end_time = clock();
@@ -47,6 +50,7 @@ static void display_statistics() {
         std::cerr.flush();
         
         g_solver->collect_statistics(g_st);
+        g_st.update("load time", g_load_time);
         g_st.update("total time", ((static_cast<double>(end_time) - static_cast<double>(g_start_time)) / CLOCKS_PER_SEC));
         g_st.display_smt2(std::cout);
     }
@@ -231,17 +235,22 @@ unsigned read_dimacs(char const * file_name) {
     sat::solver solver(p, limit);
     g_solver = &solver;
 
+    stopwatch load_watch;
+    load_watch.start();
     if (file_name) {
-        std::ifstream in(file_name);
-        if (in.bad() || in.fail()) {
+        mapped_file in;
+        if (!in.open(file_name)) {
             std::cerr << "(error \"failed to open file '" << file_name << "'\")" << std::endl;
             exit(ERR_OPEN_FILE);
         }
-        parse_dimacs(in, std::cerr, solver);
+        parse_dimacs(in.begin(), in.end(), std::cerr, solver, sp.dimacs_threads());
     }
     else {
         parse_dimacs(std::cin, std::cerr, solver);
     }
+    load_watch.stop();
+    g_load_time = load_watch.get_seconds();
+    IF_VERBOSE(2, verbose_stream() << "(sat.dimacs :load-time " << g_load_time << ")\n";);
     IF_VERBOSE(20, solver.display_status(verbose_stream()););
     
     lbool r;
@@ -18,6 +18,7 @@ Revision History:
 
 --*/
 #include<iostream>
+#include<vector>
 #include "util/memory_manager.h"
 #include "util/trace.h"
 #include "util/debug.h"
@@ -53,6 +54,9 @@ static input_kind   g_input_kind          = IN_UNSPECIFIED;
 bool                g_display_statistics  = false;
 bool                g_display_model       = false;
 static bool         g_display_istatistics = false;
+static bool         g_batch               = false;
+static char const * g_batch_delimiter     = ";; end-of-script";
+static std::vector<std::pair<std::string, std::string>> g_cmd_line_params;
 
 static void error(const char * msg) {
     std::cerr << "Error: " << msg << "\n";
@@ -60,6 +64,19 @@ static void error(const char * msg) {
     exit(ERR_CMD_LINE);
 }
 
+// set a parameter given on the command line, the batch mode restores them before every script.
+static void set_param(char const * name, char const * value) {
+    gparams::set(name, value);
+    g_cmd_line_params.push_back(std::make_pair(std::string(name), std::string(value)));
+}
+
+static void reset_params() {
+    gparams::reset();
+    for (auto const& [name, value] : g_cmd_line_params)
+        gparams::set(name.c_str(), value.c_str());
+    env_params::updt_params();
+}
+
 #define STRINGIZE(x) #x
 #define STRINGIZE_VALUE_OF(x) STRINGIZE(x)
 
@@ -86,6 +103,9 @@ void display_usage() {
     std::cout << "  -lp         use parser for a modest subset of CPLEX LP input format.\n";
     std::cout << "  -log        use parser for Z3 log input format.\n";
     std::cout << "  -in         read formula from standard input.\n";
+    std::cout << "  -batch[:delimiter]  read SMT 2 scripts from standard input, separated by lines\n";
+    std::cout << "                      consisting of the delimiter (default: '" << g_batch_delimiter << "').\n";
+    std::cout << "                      Every script runs in a fresh context and is followed by the delimiter on the output.\n";
     std::cout << "  -model      display model for satisfiable SMT.\n";
     std::cout << "\nMiscellaneous:\n";
     std::cout << "  -h, -?      prints this message.\n";
@@ -191,6 +211,12 @@ static void parse_cmd_line_args(std::string& input_file, int argc, char ** argv)
             else if (strcmp(opt_name, "in") == 0) {
                 g_standard_input = true;
             }
+            else if (strcmp(opt_name, "batch") == 0) {
+                g_standard_input = true;
+                g_batch = true;
+                if (opt_arg)
+                    g_batch_delimiter = opt_arg;
+            }
             else if (strcmp(opt_name, "dimacs") == 0) {
                 g_input_kind = IN_DIMACS;
             }
@@ -208,7 +234,7 @@ static void parse_cmd_line_args(std::string& input_file, int argc, char ** argv)
             }
             else if (strcmp(opt_name, "st") == 0) {
                 g_display_statistics = true; 
-                gparams::set("stats", "true");
+                set_param("stats", "true");
             }
             else if (strcmp(opt_name, "model") == 0) {
                 g_display_model = true;
@@ -233,7 +259,7 @@ static void parse_cmd_line_args(std::string& input_file, int argc, char ** argv)
             else if (strcmp(opt_name, "t") == 0) {
                 if (!opt_arg)
                     error("option argument (-t:timeout) is missing.");
-                gparams::set("timeout", opt_arg);
+                set_param("timeout", opt_arg);
             }
             else if (strcmp(opt_name, "nw") == 0) {
                 enable_warning_messages(false);
@@ -277,7 +303,7 @@ static void parse_cmd_line_args(std::string& input_file, int argc, char ** argv)
             else if (strcmp(opt_name, "memory") == 0) {
                 if (!opt_arg)
                     error("option argument (-memory:val) is missing.");
-                gparams::set("memory_max_size", opt_arg);
+                set_param("memory_max_size", opt_arg);
             }
             else if (strcmp(opt_name, "tactics") == 0) {
                 if (!opt_arg)
@@ -298,7 +324,7 @@ static void parse_cmd_line_args(std::string& input_file, int argc, char ** argv)
             char * key   = argv[i];
             *eq_pos      = 0;
             char * value = eq_pos+1; 
-            gparams::set(key, value);
+            set_param(key, value);
         }
         else {
             if (get_extension(arg) && strcmp(get_extension(arg), "drat") == 0) {
@@ -333,6 +359,9 @@ int STD_CALL main(int argc, char ** argv) {
         if (!g_input_file && !g_standard_input) {
             error("input file was not specified.");
         }
+        if (g_batch && g_input_kind != IN_UNSPECIFIED && g_input_kind != IN_SMTLIB_2) {
+            error("batch mode is only supported for SMT 2 input.");
+        }
         
         if (g_input_kind == IN_UNSPECIFIED) {
             g_input_kind = IN_SMTLIB_2;
@@ -368,7 +397,10 @@ int STD_CALL main(int argc, char ** argv) {
         switch (g_input_kind) {
         case IN_SMTLIB_2:
             memory::exit_when_out_of_memory(true, "(error \"out of memory\")");
-            return_value = read_smtlib2_commands(g_input_file);
+            if (g_batch)
+                return_value = read_smtlib2_batch(g_batch_delimiter, reset_params);
+            else
+                return_value = read_smtlib2_commands(g_input_file);
             break;
         case IN_DIMACS:
             return_value = read_dimacs(g_input_file);
@@ -11,6 +11,8 @@ Copyright (c) 2015 Microsoft Corporation
 #include "util/cancel_eh.h"
 #include "util/scoped_timer.h"
 #include "util/mutex.h"
+#include "util/mapped_file.h"
+#include "util/stopwatch.h"
 #include "ast/ast_util.h"
 #include "ast/arith_decl_plugin.h"
 #include "ast/ast_pp.h"
@@ -25,6 +27,7 @@ extern bool g_display_model;
 static bool g_first_interrupt = true;
 static opt::context* g_opt = nullptr;
 static double g_start_time = 0;
+static double g_load_time = 0;
 static unsigned_vector g_handles;
 static mutex *display_stats_mux = new mutex;
 
@@ -62,6 +65,7 @@ static void display_statistics() {
     if (g_display_statistics && g_opt) {
         ::statistics stats;
         g_opt->collect_statistics(stats);
+        stats.update("load time", g_load_time);
         stats.display(std::cout);
         double end_time = static_cast<double>(clock());
         std::cout << "time:                " << (end_time - g_start_time)/CLOCKS_PER_SEC << " secs\n";
@@ -87,24 +91,38 @@ static void on_timeout() {
     _Exit(0);
 }
 
-static unsigned parse_opt(std::istream& in, opt_format f) {
+// parse from in, or from the range [begin, end) if in is null.
+static unsigned parse_opt(std::istream* in, char const* begin, char const* end, opt_format f) {
     ast_manager m;
     reg_decl_plugins(m);
     opt::context opt(m);
     g_opt = &opt;
     params_ref p = gparams::get_module("opt");
     opt.updt_params(p);
+    stopwatch load_watch;
+    load_watch.start();
     switch (f) {
     case wcnf_t:
-        parse_wcnf(opt, in, g_handles);
+        if (in)
+            parse_wcnf(opt, *in, g_handles);
+        else
+            parse_wcnf(opt, begin, end, g_handles);
         break;
     case opb_t:
-        parse_opb(opt, in, g_handles);
+        if (in)
+            parse_opb(opt, *in, g_handles);
+        else
+            parse_opb(opt, begin, end, g_handles);
         break;
     case lp_t:
-        parse_lp(opt, in, g_handles);
+        if (in)
+            parse_lp(opt, *in, g_handles);
+        else
+            parse_lp(opt, begin, end, g_handles);
         break;
     }
+    load_watch.stop();
+    g_load_time = load_watch.get_seconds();
     try {
         cancel_eh<reslimit> eh(m.limit());
         unsigned timeout = std::stoul(gparams::get_value("timeout"));
@@ -146,15 +164,15 @@ unsigned parse_opt(char const* file_name, opt_format f) {
     register_on_timeout_proc(on_timeout);
     signal(SIGINT, on_ctrl_c);
     if (file_name) {
-        std::ifstream in(file_name);
-        if (in.bad() || in.fail()) {
+        mapped_file in;
+        if (!in.open(file_name)) {
             std::cerr << "(error \"failed to open file '" << file_name << "'\")" << std::endl;
             exit(ERR_OPEN_FILE);
         }
-        return parse_opt(in, f);
+        return parse_opt(nullptr, in.begin(), in.end(), f);
     }
     else {
-        return parse_opt(std::cin, f);
+        return parse_opt(&std::cin, nullptr, nullptr, f);
     }
 }
 
@@ -21,6 +21,7 @@ Revision History:
 #include<iostream>
 #include<time.h>
 #include<signal.h>
+#include<sstream>
 #include "util/timeout.h"
 #include "util/mutex.h"
 #include "parsers/smt2/smt2parser.h"
@@ -115,12 +116,7 @@ void help_probes() {
         std::cout << "- " << cmd->get_name() << " " << cmd->get_descr() << "\n";
 }
 
-unsigned read_smtlib2_commands(char const * file_name) {
-    g_start_time = clock();
-    register_on_timeout_proc(on_timeout);
-    signal(SIGINT, on_ctrl_c);
-    cmd_context ctx;
-
+static void init_cmd_context(cmd_context & ctx) {
     ctx.set_solver_factory(mk_smt_strategic_solver_factory());
     install_dl_cmds(ctx);
     install_dbg_cmds(ctx);
@@ -128,6 +124,15 @@ unsigned read_smtlib2_commands(char const * file_name) {
     install_subpaving_cmds(ctx);
     install_opt_cmds(ctx);
     install_smt2_extra_cmds(ctx);
+}
+
+unsigned read_smtlib2_commands(char const * file_name) {
+    g_start_time = clock();
+    register_on_timeout_proc(on_timeout);
+    signal(SIGINT, on_ctrl_c);
+    cmd_context ctx;
+
+    init_cmd_context(ctx);
 
     g_cmd_context = &ctx;
     signal(SIGINT, on_ctrl_c);
@@ -151,3 +156,53 @@ unsigned read_smtlib2_commands(char const * file_name) {
     return result ? 0 : 1;
 }
 
+
+/**
+   \brief Process SMT 2 scripts from standard input in a single process.
+   Scripts are separated by lines consisting of the delimiter. Every script is
+   processed in a fresh command context after the command line parameters are
+   restored by reset_params, so declarations and options do not leak between scripts.
+   The delimiter is echoed after the output of every script.
+   Soft timeouts (-t) and resource limits (rlimit) apply to every query of a script.
+*/
+unsigned read_smtlib2_batch(char const * delimiter, std::function<void(void)> const& reset_params) {
+    register_on_timeout_proc(on_timeout);
+    signal(SIGINT, on_ctrl_c);
+    bool result = true;
+    bool eof = false;
+    std::string line, script;
+    while (!eof) {
+        script.clear();
+        bool has_lines = false;
+        while (true) {
+            if (!std::getline(std::cin, line)) {
+                eof = true;
+                break;
+            }
+            if (!line.empty() && line.back() == '\r')
+                line.pop_back();
+            if (line == delimiter)
+                break;
+            script += line;
+            script += '\n';
+            has_lines = true;
+        }
+        if (eof && !has_lines)
+            break;
+        reset_params();
+        g_start_time = clock();
+        {
+            cmd_context ctx;
+            init_cmd_context(ctx);
+            g_cmd_context = &ctx;
+            std::istringstream in(script);
+            if (!parse_smt2_commands(ctx, in))
+                result = false;
+            display_statistics();
+            display_model();
+            g_cmd_context = nullptr;
+        }
+        std::cout << delimiter << std::endl;
+    }
+    return result ? 0 : 1;
+}
@@ -18,8 +18,11 @@ Revision History:
 --*/
 #pragma once
 
+#include <functional>
+
 unsigned read_smtlib_file(char const * benchmark_file);
 unsigned read_smtlib2_commands(char const * command_file);
+unsigned read_smtlib2_batch(char const * delimiter, std::function<void(void)> const& reset_params);
 void help_tactics();
 void help_probes();
 void help_tactic(char const* name);
@@ -17,10 +17,19 @@ Revision History:
 
 --*/
 #include <algorithm>
+#include <atomic>
+#ifndef SINGLE_THREAD
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <thread>
+#endif
 
 #include "util/pool.h"
 #include "util/trail.h"
 #include "util/stopwatch.h"
+#include "util/uint_set.h"
+#include "util/scoped_ptr_vector.h"
 #include "ast/ast_pp.h"
 #include "ast/ast_ll_pp.h"
 #include "ast/ast_smt2_pp.h"
@@ -1863,6 +1872,55 @@ namespace {
 
         pool<enode_vector>  m_pool;
 
+    public:
+        // match recorded by an interpreter that runs concurrently with other interpreters.
+        struct pending_match {
+            quantifier * m_qa;
+            app *        m_pat;
+            unsigned     m_num_bindings;
+            unsigned     m_bindings_offset;
+            unsigned     m_max_generation;
+            unsigned     m_min_top_generation;
+            unsigned     m_max_top_generation;
+        };
+    private:
+        // In concurrent mode the interpreter only reads the E-graph and 
+        // records matches instead of reporting them to the mam.
+        bool                   m_concurrent { false };
+        svector<pending_match> m_matches;
+        enode_vector           m_match_bindings;
+        tmp_enode              m_tmp_enode;
+        uint_set               m_seen;
+        std::atomic<unsigned>* m_limit_checks { nullptr }; // checks of all concurrent interpreters
+
+        // Concurrent interpreters must not update the shared resource limit.
+        // They count their checks in a shared counter and stop when the limit
+        // would be exceeded by that many increments; the mam charges the checks
+        // to the resource limit after the workers are done.
+        bool cancel_requested() {
+            if (!m_concurrent)
+                return m_context.get_cancel_flag();
+            return !m.limit().not_canceled(++*m_limit_checks);
+        }
+
+        bool limits_exceeded() {
+            if (!m_concurrent)
+                return m_context.resource_limits_exceeded();
+            return cancel_requested() || memory::above_high_watermark();
+        }
+
+        void record_match(quantifier * qa, app * pat, unsigned num_bindings) {
+            pending_match pm;
+            pm.m_qa = qa;
+            pm.m_pat = pat;
+            pm.m_num_bindings = num_bindings;
+            pm.m_bindings_offset = m_match_bindings.size();
+            pm.m_max_generation = m_max_generation;
+            get_min_max_top_generation(pm.m_min_top_generation, pm.m_max_top_generation);
+            m_match_bindings.append(num_bindings, m_bindings.data());
+            m_matches.push_back(pm);
+        }
+
         enode_vector * mk_enode_vector() {
             enode_vector * r = m_pool.mk();
             r->reset();
@@ -1997,6 +2055,22 @@ namespace {
         ~interpreter() {
         }
 
+        void set_concurrent(std::atomic<unsigned>& limit_checks) { 
+            m_concurrent = true; 
+            m_limit_checks = &limit_checks;
+        }
+
+        void reset_matches() {
+            m_matches.reset();
+            m_match_bindings.reset();
+        }
+
+        unsigned num_matches() const { return m_matches.size(); }
+
+        pending_match const & get_match(unsigned i) const { return m_matches[i]; }
+
+        enode * const * get_match_bindings(pending_match const & pm) const { return m_match_bindings.data() + pm.m_bindings_offset; }
+
         void init(code_tree * t) {
             TRACE("mam_bug", tout << "preparing to match tree:\n" << *t << "\n";);
             m_registers.reserve(t->get_num_regs(), nullptr);
@@ -2008,7 +2082,19 @@ namespace {
         void execute(code_tree * t) {
             TRACE("trigger_bug", tout << "execute for code tree:\n"; t->display(tout););
             init(t);
-            if (t->filter_candidates()) {
+            if (t->filter_candidates() && m_concurrent) {
+                // enode marks are shared with other interpreters.
+                for (enode* app : t->get_candidates()) {
+                    if (!m_seen.contains(app->get_owner_id()) && app->is_cgr()) {
+                        if (limits_exceeded() || !execute_core(t, app))
+                            break;
+                        m_seen.insert(app->get_owner_id());
+                    }
+                }
+                for (enode* app : t->get_candidates()) 
+                    m_seen.remove(app->get_owner_id());
+            }
+            else if (t->filter_candidates()) {
                 for (enode* app : t->get_candidates()) {
                     TRACE("trigger_bug", tout << "candidate\n" << mk_ismt2_pp(app->get_expr(), m) << "\n";);
                     if (!app->is_marked() && app->is_cgr()) {
@@ -2027,7 +2113,7 @@ namespace {
                     TRACE("trigger_bug", tout << "candidate\n" << mk_ismt2_pp(app->get_expr(), m) << "\n";);
                     if (app->is_cgr()) {
                         TRACE("trigger_bug", tout << "is_cgr\n";);
-                        if (m_context.resource_limits_exceeded() || !execute_core(t, app))
+                        if (limits_exceeded() || !execute_core(t, app))
                             return;
                     }
                 }
@@ -2530,14 +2616,19 @@ namespace {
             m_bindings[0] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[0]];
 #define ON_MATCH(NUM)                                                   \
             m_max_generation = std::max(m_max_generation, get_max_generation(NUM, m_bindings.begin())); \
-            if (m_context.get_cancel_flag()) {                          \
+            if (cancel_requested()) {                                   \
                 return false;                                           \
             }                                                           \
-            m_mam.on_match(static_cast<const yield *>(m_pc)->m_qa,                                      \
-                           static_cast<const yield *>(m_pc)->m_pat,                                     \
-                           NUM,                                                                         \
-                           m_bindings.begin(),                                                          \
-                           m_max_generation, m_used_enodes)
+            if (m_concurrent)                                           \
+                record_match(static_cast<const yield *>(m_pc)->m_qa,    \
+                             static_cast<const yield *>(m_pc)->m_pat,   \
+                             NUM);                                      \
+            else                                                        \
+                m_mam.on_match(static_cast<const yield *>(m_pc)->m_qa,                                  \
+                               static_cast<const yield *>(m_pc)->m_pat,                                 \
+                               NUM,                                                                     \
+                               m_bindings.begin(),                                                      \
+                               m_max_generation, m_used_enodes)
             ON_MATCH(1);
             goto backtrack;
 
@@ -2595,7 +2686,9 @@ namespace {
 
         case GET_CGR1:
 #define GET_CGR_COMMON()                                                                                                                                                \
-            m_n1 = m_context.get_enode_eq_to(static_cast<const get_cgr *>(m_pc)->m_label, static_cast<const get_cgr *>(m_pc)->m_num_args, m_args.data());              \
+            m_n1 = m_concurrent ?                                                                                                                                       \
+                m_context.get_enode_eq_to(static_cast<const get_cgr *>(m_pc)->m_label, static_cast<const get_cgr *>(m_pc)->m_num_args, m_args.data(), m_tmp_enode) :   \
+                m_context.get_enode_eq_to(static_cast<const get_cgr *>(m_pc)->m_label, static_cast<const get_cgr *>(m_pc)->m_num_args, m_args.data());                  \
             if (m_n1 == 0 || !m_context.is_relevant(m_n1))                                                                                                              \
                 goto backtrack;                                                                                                                                         \
             update_max_generation(m_n1, nullptr);                                                                                                                       \
@@ -2706,7 +2799,7 @@ namespace {
 
         if (since_last_check++ > 100) {
             since_last_check = 0;
-            if (m_context.resource_limits_exceeded()) {
+            if (limits_exceeded()) {
                 // Soft timeout...
                 // Cleanup before exiting
                 while (m_top != 0) {
@@ -3075,6 +3168,76 @@ namespace {
 
     typedef std::pair<path_tree *, path_tree *> path_tree_pair;
 
+#ifndef SINGLE_THREAD
+    /**
+       \brief Threads used for parallel matching. They are created once
+       and wait for work between calls to run.
+    */
+    class match_pool {
+        std::mutex                    m_mux;
+        std::condition_variable       m_cond;
+        std::function<void(unsigned)> m_job;
+        unsigned                      m_round { 0 };
+        unsigned                      m_running { 0 };
+        bool                          m_done { false };
+        vector<std::thread>           m_threads;
+
+        void wait_for_jobs(unsigned id, unsigned round) {
+            std::unique_lock<std::mutex> lock(m_mux);
+            while (true) {
+                m_cond.wait(lock, [&]() { return m_done || m_round != round; });
+                if (m_done)
+                    return;
+                round = m_round;
+                lock.unlock();
+                m_job(id);
+                lock.lock();
+                if (--m_running == 0)
+                    m_cond.notify_all();
+            }
+        }
+
+    public:
+        ~match_pool() {
+            {
+                std::lock_guard<std::mutex> lock(m_mux);
+                m_done = true;
+                m_cond.notify_all();
+            }
+            for (auto& th : m_threads)
+                th.join();
+        }
+
+        // number of threads, including the thread calling run.
+        unsigned size() const { return m_threads.size() + 1; }
+
+        void reserve(unsigned n) {
+            std::lock_guard<std::mutex> lock(m_mux);
+            while (size() < n) {
+                unsigned id = size();
+                m_threads.push_back(std::thread([this, id, round = m_round]() { wait_for_jobs(id, round); }));
+            }
+        }
+
+        /**
+           \brief run job(i) for every thread i. The calling thread runs job(0).
+           job must not throw.
+        */
+        void run(std::function<void(unsigned)> const& job) {
+            {
+                std::lock_guard<std::mutex> lock(m_mux);
+                m_job = job;
+                m_running = m_threads.size();
+                ++m_round;
+                m_cond.notify_all();
+            }
+            job(0);
+            std::unique_lock<std::mutex> lock(m_mux);
+            m_cond.wait(lock, [&]() { return m_running == 0; });
+        }
+    };
+#endif
+
     // ------------------------------------
     //
     // Matching Abstract Machine Implementation
@@ -3094,6 +3257,11 @@ namespace {
         ptr_vector<code_tree>       m_tmp_trees;
         ptr_vector<func_decl>       m_tmp_trees_to_delete;
         ptr_vector<code_tree>       m_to_match;
+        scoped_ptr_vector<interpreter> m_workers; // interpreters used for matching in parallel
+        std::atomic<unsigned>       m_limit_checks { 0 };
+#ifndef SINGLE_THREAD
+        scoped_ptr<match_pool>      m_match_pool;
+#endif
         typedef std::pair<quantifier *, app *> qp_pair;
         svector<qp_pair>            m_new_patterns; // recently added patterns
 
@@ -3881,12 +4049,90 @@ namespace {
             }
         }
 
+        /**
+           \brief Match the code trees in m_to_match using smt.ematching.threads interpreters.
+           The E-graph is not updated while matching, so the interpreters only read it.
+           Matches are recorded per code tree and added to the instantiation queue in the order 
+           of m_to_match, so instances are created in the same order as by sequential matching.
+           The threads are kept in m_match_pool between calls.
+        */
+        bool match_parallel() {
+#ifdef SINGLE_THREAD
+            return false;
+#else
+            unsigned num_threads = std::min(m_context.get_fparams().m_ematching_threads, (unsigned) std::thread::hardware_concurrency());
+            num_threads = std::min(num_threads, m_to_match.size());
+            if (num_threads <= 1 || m.has_trace_stream() || is_trace_enabled("causality"))
+                return false;
+            unsigned num_candidates = 0;
+            for (code_tree* t : m_to_match)
+                num_candidates += t->get_candidates().size();
+            if (num_candidates < 64 * num_threads)
+                return false;
+            if (!m_match_pool)
+                m_match_pool = alloc(match_pool);
+            m_match_pool->reserve(num_threads);
+            num_threads = m_match_pool->size();
+            while (m_workers.size() < num_threads) {
+                m_workers.push_back(alloc(interpreter, m_context, *this, m_use_filters));
+                m_workers.back()->set_concurrent(m_limit_checks);
+            }
+
+            struct tree_matches {
+                unsigned m_worker { 0 };
+                unsigned m_begin { 0 };
+                unsigned m_end { 0 };
+            };
+            vector<tree_matches> matches(m_to_match.size());
+            std::atomic<unsigned> next(0);
+            std::mutex mux;
+            std::exception_ptr ex;
+            m_limit_checks = 0;
+            m_match_pool->run([&](unsigned id) {
+                interpreter& w = *m_workers[id];
+                w.reset_matches();
+                try {
+                    for (unsigned i = next++; i < m_to_match.size(); i = next++) {
+                        matches[i].m_worker = id;
+                        matches[i].m_begin = w.num_matches();
+                        w.execute(m_to_match[i]);
+                        matches[i].m_end = w.num_matches();
+                    }
+                }
+                catch (...) {
+                    std::lock_guard<std::mutex> lock(mux);
+                    if (!ex)
+                        ex = std::current_exception();
+                    next = m_to_match.size();
+                }
+            });
+            m.limit().inc(m_limit_checks);
+            if (ex)
+                std::rethrow_exception(ex);
+
+            vector<std::tuple<enode *, enode *>> used_enodes;
+            for (tree_matches const& tm : matches) {
+                interpreter& w = *m_workers[tm.m_worker];
+                for (unsigned j = tm.m_begin; j < tm.m_end; ++j) {
+                    interpreter::pending_match const& pm = w.get_match(j);
+                    add_match(pm.m_qa, pm.m_pat, pm.m_num_bindings, w.get_match_bindings(pm), 
+                              pm.m_max_generation, pm.m_min_top_generation, pm.m_max_top_generation, used_enodes);
+                }
+            }
+            for (code_tree* t : m_to_match)
+                t->reset_candidates();
+            return true;
+#endif
+        }
+
         void match() override {
             TRACE("trigger_bug", tout << "match\n"; display(tout););
-            for (code_tree* t : m_to_match) {
-                SASSERT(t->has_candidates());
-                m_interpreter.execute(t);
-                t->reset_candidates();
+            if (!match_parallel()) {
+                for (code_tree* t : m_to_match) {
+                    SASSERT(t->has_candidates());
+                    m_interpreter.execute(t);
+                    t->reset_candidates();
+                }
             }
             m_to_match.reset();
             if (!m_new_patterns.empty()) {
@@ -3923,6 +4169,14 @@ namespace {
 
         void on_match(quantifier * qa, app * pat, unsigned num_bindings, enode * const * bindings, unsigned max_generation, vector<std::tuple<enode *, enode *>> & used_enodes) override {
             TRACE("trigger_bug", tout << "found match " << mk_pp(qa, m) << "\n";);
+            unsigned min_gen = 0, max_gen = 0;
+            m_interpreter.get_min_max_top_generation(min_gen, max_gen);
+            add_match(qa, pat, num_bindings, bindings, max_generation, min_gen, max_gen, used_enodes);
+        }
+
+        // matches found by sequential and by parallel matching are added here.
+        void add_match(quantifier * qa, app * pat, unsigned num_bindings, enode * const * bindings, unsigned max_generation, 
+                       unsigned min_gen, unsigned max_gen, vector<std::tuple<enode *, enode *>> & used_enodes) {
 #ifdef Z3DEBUG
             if (m_check_missing_instances) {
                 if (!m_context.slow_contains_instance(qa, num_bindings, bindings)) {
@@ -3939,8 +4193,6 @@ namespace {
                 SASSERT(bindings[i]->get_generation() <= max_generation);
             }
 #endif
-            unsigned min_gen = 0, max_gen = 0;
-            m_interpreter.get_min_max_top_generation(min_gen, max_gen);
             m_context.add_instance(qa, pat, num_bindings, bindings, nullptr, max_generation, min_gen, max_gen, used_enodes);
         }
 
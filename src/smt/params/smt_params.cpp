@@ -26,8 +26,11 @@ void smt_params::updt_local_params(params_ref const & _p) {
     m_random_seed = p.random_seed();
     m_relevancy_lvl = p.relevancy();
     m_ematching   = p.ematching();
+    m_ematching_threads = p.ematching_threads();
     m_induction   = p.induction();
     m_clause_proof = p.clause_proof();
+    m_profile = p.profile();
+    m_profile_file = p.profile_file();
     m_phase_selection = static_cast<phase_selection>(p.phase_selection());
     if (m_phase_selection > PS_THEORY) throw default_exception("illegal phase selection numeral");
     m_phase_caching_on = p.phase_caching_on();
@@ -35,6 +38,12 @@ void smt_params::updt_local_params(params_ref const & _p) {
     m_restart_strategy = static_cast<restart_strategy>(p.restart_strategy());
     if (m_restart_strategy > RS_ARITHMETIC) throw default_exception("illegal restart strategy numeral");
     m_restart_factor = p.restart_factor();
+    m_lemma_gc_strategy = static_cast<lemma_gc_strategy>(p.lemma_gc_strategy());
+    if (m_lemma_gc_strategy > LGC_NONE) throw default_exception("illegal lemma gc strategy numeral");
+    m_lemma_gc_tiered = p.lemma_gc_tiered();
+    m_lemma_gc_tier1_glue = p.lemma_gc_tier1_glue();
+    m_lemma_gc_tier2_glue = p.lemma_gc_tier2_glue();
+    m_phase_transfer_lemma_size = p.phase_transfer_lemma_size();
     m_case_split_strategy = static_cast<case_split_strategy>(p.case_split());
     m_theory_case_split = p.theory_case_split();
     m_theory_aware_branching = p.theory_aware_branching();
@@ -47,6 +56,8 @@ void smt_params::updt_local_params(params_ref const & _p) {
     m_threads       = p.threads();
     m_threads_max_conflicts  = p.threads_max_conflicts();
     m_threads_cube_frequency = p.threads_cube_frequency();
+    m_threads_share_glue     = p.threads_share_glue();
+    m_threads_share_size     = p.threads_share_size();
     m_core_validate = p.core_validate();
     m_logic = _p.get_sym("logic", m_logic);
     m_string_solver = p.string_solver();
@@ -114,13 +125,18 @@ void smt_params::display(std::ostream & out) const {
     DISPLAY_PARAM(m_threads);
     DISPLAY_PARAM(m_threads_max_conflicts);
     DISPLAY_PARAM(m_threads_cube_frequency);
+    DISPLAY_PARAM(m_threads_share_glue);
+    DISPLAY_PARAM(m_threads_share_size);
     DISPLAY_PARAM(m_simplify_clauses);
     DISPLAY_PARAM(m_tick);
     DISPLAY_PARAM(m_display_features);
     DISPLAY_PARAM(m_new_core2th_eq);
     DISPLAY_PARAM(m_ematching);
+    DISPLAY_PARAM(m_ematching_threads);
     DISPLAY_PARAM(m_induction);
     DISPLAY_PARAM(m_clause_proof);
+    DISPLAY_PARAM(m_profile);
+    DISPLAY_PARAM(m_profile_file);
 
     DISPLAY_PARAM(m_case_split_strategy);
     DISPLAY_PARAM(m_rel_case_split_order);
@@ -140,6 +156,10 @@ void smt_params::display(std::ostream & out) const {
 
     DISPLAY_PARAM(m_lemma_gc_strategy);
     DISPLAY_PARAM(m_lemma_gc_half);
+    DISPLAY_PARAM(m_lemma_gc_tiered);
+    DISPLAY_PARAM(m_lemma_gc_tier1_glue);
+    DISPLAY_PARAM(m_lemma_gc_tier2_glue);
+    DISPLAY_PARAM(m_phase_transfer_lemma_size);
     DISPLAY_PARAM(m_recent_lemmas_size);
     DISPLAY_PARAM(m_lemma_gc_initial);
     DISPLAY_PARAM(m_lemma_gc_factor);
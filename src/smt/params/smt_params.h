@@ -105,13 +105,18 @@ struct smt_params : public preprocessor_params,
     unsigned         m_threads;
     unsigned         m_threads_max_conflicts;
     unsigned         m_threads_cube_frequency;
+    unsigned         m_threads_share_glue;
+    unsigned         m_threads_share_size;
     bool             m_simplify_clauses;
     unsigned         m_tick;
     bool             m_display_features;
     bool             m_new_core2th_eq;
     bool             m_ematching;
+    unsigned         m_ematching_threads;
     bool             m_induction;
     bool             m_clause_proof;
+    bool             m_profile;
+    std::string      m_profile_file;
 
     // -----------------------------------
     //
@@ -158,6 +163,10 @@ struct smt_params : public preprocessor_params,
     // -----------------------------------
     lemma_gc_strategy m_lemma_gc_strategy;
     bool              m_lemma_gc_half;
+    bool              m_lemma_gc_tiered;
+    unsigned          m_lemma_gc_tier1_glue;
+    unsigned          m_lemma_gc_tier2_glue;
+    unsigned          m_phase_transfer_lemma_size;
     unsigned          m_recent_lemmas_size;
     unsigned          m_lemma_gc_initial;
     double            m_lemma_gc_factor;
@@ -260,13 +269,17 @@ struct smt_params : public preprocessor_params,
         m_threads(1),
         m_threads_max_conflicts(UINT_MAX),
         m_threads_cube_frequency(2),
+        m_threads_share_glue(2),
+        m_threads_share_size(8),
         m_simplify_clauses(true),
         m_tick(1000),
         m_display_features(false),
         m_new_core2th_eq(true),
         m_ematching(true),
+        m_ematching_threads(1),
         m_induction(false),
         m_clause_proof(false),
+        m_profile(false),
         m_case_split_strategy(case_split_strategy::CS_ACTIVITY_DELAY_NEW),
         m_rel_case_split_order(0),
         m_lookahead_diseq(false),
@@ -283,6 +296,10 @@ struct smt_params : public preprocessor_params,
         m_restart_agility_threshold(0.18),
         m_lemma_gc_strategy(lemma_gc_strategy::LGC_FIXED),
         m_lemma_gc_half(false),
+        m_lemma_gc_tiered(false),
+        m_lemma_gc_tier1_glue(2),
+        m_lemma_gc_tier2_glue(6),
+        m_phase_transfer_lemma_size(4),
         m_recent_lemmas_size(100),
         m_lemma_gc_initial(5000),
         m_lemma_gc_factor(1.1),
@@ -36,6 +36,10 @@ namespace smt {
         m_new_gen_function(m),
         m_parser(m),
         m_evaluator(m),
+        m_cost_program(m),
+        m_new_gen_program(m),
+        m_profile(false),
+        m_num_cost_evals(0),
         m_subst(m),
         m_instances(m) {
         init_parser_vars();
@@ -43,6 +47,8 @@ namespace smt {
     }
 
     qi_queue::~qi_queue() {
+        if (m_profile && m_num_cost_evals > 0) 
+            verbose_stream() << "[qi_cost] evaluations: " << m_num_cost_evals << " time: " << m_cost_watch.get_seconds() << "s\n";
     }
 
     void qi_queue::setup() {
@@ -63,6 +69,21 @@ namespace smt {
             VERIFY(m_parser.parse_string("cost", m_new_gen_function));
         }
         m_eager_cost_threshold = m_params.m_qi_eager_threshold;
+        m_profile = m_params.m_qi_profile;
+        m_cost_program.compile(m_cost_function, m_vals.size());
+        m_new_gen_program.compile(m_new_gen_function, m_vals.size());
+        TRACE("qi_cost", tout << "compiled cost: " << m_cost_program.compiled() << " new-gen: " << m_new_gen_program.compiled() << "\n";);
+    }
+
+    float qi_queue::eval(cost_program & p, expr * f) {
+        if (m_profile) {
+            ++m_num_cost_evals;
+            m_cost_watch.start();
+        }
+        float r = p.compiled() ? p(m_vals.data()) : m_evaluator(f, m_vals.size(), m_vals.data());
+        if (m_profile)
+            m_cost_watch.stop();
+        return r;
     }
 
     void qi_queue::init_parser_vars() {
@@ -121,7 +142,7 @@ namespace smt {
 
     float qi_queue::get_cost(quantifier * q, app * pat, unsigned generation, unsigned min_top_generation, unsigned max_top_generation) {
         q::quantifier_stat * stat = set_values(q, pat, generation, min_top_generation, max_top_generation, 0);
-        float r = m_evaluator(m_cost_function, m_vals.size(), m_vals.data());
+        float r = eval(m_cost_program, m_cost_function);
         stat->update_max_cost(r);
         return r;
     }
@@ -129,7 +150,7 @@ namespace smt {
     unsigned qi_queue::get_new_gen(quantifier * q, unsigned generation, float cost) {
         // max_top_generation and min_top_generation are not available for computing inc_gen
         set_values(q, nullptr, generation, 0, 0, cost);
-        float r = m_evaluator(m_new_gen_function, m_vals.size(), m_vals.data());
+        float r = eval(m_new_gen_program, m_new_gen_function);
         return std::max(generation + 1, static_cast<unsigned>(r));
     }
 
@@ -479,6 +500,10 @@ namespace smt {
         get_min_max_costs(min, max);
         st.update("min missed qa cost", min);
         st.update("max missed qa cost", max);
+        if (m_profile) {
+            st.update("quant cost evaluations", m_num_cost_evals);
+            st.update("quant cost time", m_cost_watch.get_seconds());
+        }
 #if 0
         if (m_params.m_qi_profile) {
             out << "missed/delayed quantifier instances:\n";
@@ -28,6 +28,7 @@ Revision History:
 #include "smt/params/qi_params.h"
 #include "ast/cost_evaluator.h"
 #include "util/statistics.h"
+#include "util/stopwatch.h"
 
 namespace smt {
     class context;
@@ -49,6 +50,11 @@ namespace smt {
         expr_ref                      m_new_gen_function;
         cost_parser                   m_parser;
         cost_evaluator                m_evaluator;
+        cost_program                  m_cost_program;
+        cost_program                  m_new_gen_program;
+        bool                          m_profile;
+        unsigned                      m_num_cost_evals;
+        stopwatch                     m_cost_watch;
         cached_var_subst              m_subst;
         svector<float>                m_vals;
         double                        m_eager_cost_threshold;
@@ -71,6 +77,7 @@ namespace smt {
         svector<scope>                m_scopes;
 
         void init_parser_vars();
+        float eval(cost_program & p, expr * f);
         q::quantifier_stat * set_values(quantifier * q, app * pat, unsigned generation, unsigned min_top_generation, unsigned max_top_generation, float cost);
         float get_cost(quantifier * q, app * pat, unsigned generation, unsigned min_top_generation, unsigned max_top_generation);
         unsigned get_new_gen(quantifier * q, unsigned generation, float cost);
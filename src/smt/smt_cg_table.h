@@ -81,25 +81,29 @@ namespace smt {
             }
         };
         
+        static bool comm_eq(enode * n1, enode * n2, bool & commutativity) {
+            SASSERT(n1->get_num_args() == 2);
+            SASSERT(n2->get_num_args() == 2);
+            SASSERT(n1->get_decl() == n2->get_decl());
+            enode * c1_1 = n1->get_arg(0)->get_root();
+            enode * c1_2 = n1->get_arg(1)->get_root();
+            enode * c2_1 = n2->get_arg(0)->get_root();
+            enode * c2_2 = n2->get_arg(1)->get_root();
+            if (c1_1 == c2_1 && c1_2 == c2_2) {
+                return true;
+            }
+            if (c1_1 == c2_2 && c1_2 == c2_1) {
+                commutativity = true;
+                return true;
+            }
+            return false;
+        }
+
         struct cg_comm_eq {
             bool & m_commutativity;
             cg_comm_eq(bool & c):m_commutativity(c) {}
             bool operator()(enode * n1, enode * n2) const {
-                SASSERT(n1->get_num_args() == 2);
-                SASSERT(n2->get_num_args() == 2);
-                SASSERT(n1->get_decl() == n2->get_decl());
-                enode * c1_1 = n1->get_arg(0)->get_root();
-                enode * c1_2 = n1->get_arg(1)->get_root();
-                enode * c2_1 = n2->get_arg(0)->get_root();
-                enode * c2_2 = n2->get_arg(1)->get_root();
-                if (c1_1 == c2_1 && c1_2 == c2_2) {
-                    return true;
-                }
-                if (c1_1 == c2_2 && c1_2 == c2_1) {
-                    m_commutativity = true;
-                    return true;
-                }
-                return false;
+                return comm_eq(n1, n2, m_commutativity);
             }
         };
 
@@ -183,6 +187,37 @@ namespace smt {
             }
         }
 
+        /**
+           \brief Find an enode congruent to n without registering the function symbol of n.
+           Unlike find, it does not write to n or to the table, so it can be used by
+           concurrent readers as long as the table is not modified.
+        */
+        enode * find_readonly(enode * n) const {
+            SASSERT(n->get_num_args() > 0);
+            unsigned tid = n->get_func_decl_id();
+            if (tid == UINT_MAX && !m_func_decl2id.find(n->get_decl(), tid))
+                return nullptr;
+            enode * const * r = nullptr;
+            void * t = m_tables[tid];
+            switch (static_cast<table_kind>(GET_TAG(t))) {
+            case UNARY:
+                r = UNTAG(unary_table*, t)->find_core(n);
+                break;
+            case BINARY:
+                r = UNTAG(binary_table*, t)->find_core(n);
+                break;
+            case BINARY_COMM: {
+                auto eq = [](enode * n1, enode * n2) { bool comm = false; return comm_eq(n1, n2, comm); };
+                r = UNTAG(comm_table*, t)->find_core(n, eq);
+                break;
+            }
+            default:
+                r = UNTAG(table*, t)->find_core(n);
+                break;
+            }
+            return r ? *r : nullptr;
+        }
+
         bool contains_ptr(enode * n) const {
             enode * r;
             SASSERT(n->get_num_args() > 0);
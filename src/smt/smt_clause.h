@@ -46,6 +46,18 @@ namespace smt {
 
     inline bool is_axiom(clause_kind k) { return k == CLS_AUX || k == CLS_TH_AXIOM; }
     inline bool is_lemma(clause_kind k) { return k == CLS_LEARNED || k == CLS_TH_LEMMA; }
+
+    /**
+       \brief Tiers of the lemma database used by the tiered lemma garbage collection.
+       Lemmas with small glue are kept in the core tier, lemmas with medium glue stay in tier2
+       as long as they are used in conflicts, and the remaining lemmas are local lemmas
+       that are deleted when they are inactive.
+    */
+    enum lemma_tier {
+        LT_CORE,
+        LT_TIER2,
+        LT_LOCAL
+    };
     
     /**
        \brief A SMT clause.
@@ -67,7 +79,7 @@ namespace smt {
         static unsigned get_obj_size(unsigned num_lits, clause_kind k, bool has_atoms, bool has_del_eh, bool has_justification) {
             unsigned r = sizeof(clause) + sizeof(literal) * num_lits;
             if (smt::is_lemma(k)) 
-                r += sizeof(unsigned);
+                r += 2 * sizeof(unsigned); // activity and tier information
             /* dvitek: Fix alignment issues on 64-bit platforms.  The
              * 'if' statement below probably isn't worthwhile since
              * I'm guessing the allocator is probably going to round
@@ -92,10 +104,19 @@ namespace smt {
             return reinterpret_cast<unsigned *>(m_lits + m_capacity);
         }
 
+        // glue, tier and usage bit of lemmas are packed in the word following the activity.
+        unsigned const * get_tier_addr() const {
+            return get_activity_addr() + 1;
+        }
+
+        unsigned * get_tier_addr() {
+            return get_activity_addr() + 1;
+        }
+
         clause_del_eh * const * get_del_eh_addr() const {
             unsigned const * addr = get_activity_addr();
             if (is_lemma())
-                addr ++;
+                addr += 2;
             /* dvitek: It would be better to use uintptr_t than
              * size_t, but we need to wait until c++11 support is
              * really available.
@@ -250,6 +271,37 @@ namespace smt {
             set_activity(get_activity() + 1);
         }
 
+        unsigned get_glue() const {
+            SASSERT(is_lemma());
+            return *(get_tier_addr()) >> 3;
+        }
+
+        void set_glue(unsigned glue) {
+            SASSERT(is_lemma());
+            glue = std::min(glue, (1u << 29) - 1);
+            *(get_tier_addr()) = (glue << 3) | (*(get_tier_addr()) & 7);
+        }
+
+        lemma_tier get_tier() const {
+            SASSERT(is_lemma());
+            return static_cast<lemma_tier>(*(get_tier_addr()) & 3);
+        }
+
+        void set_tier(lemma_tier t) {
+            SASSERT(is_lemma());
+            *(get_tier_addr()) = (*(get_tier_addr()) & ~3u) | t;
+        }
+
+        bool is_used() const {
+            SASSERT(is_lemma());
+            return (*(get_tier_addr()) & 4) != 0;
+        }
+
+        void set_used(bool f) {
+            SASSERT(is_lemma());
+            *(get_tier_addr()) = f ? (*(get_tier_addr()) | 4) : (*(get_tier_addr()) & ~4u);
+        }
+
         std::ostream& display(std::ostream & out, ast_manager & m, expr * const * bool_var2expr_map) const;
         
         std::ostream& display_smt2(std::ostream & out, ast_manager & m, expr * const * bool_var2expr_map) const;
@@ -518,8 +518,11 @@ namespace smt {
             case b_justification::CLAUSE: {
                 clause * cls = js.get_clause();
                 TRACE("conflict_smt2", m_ctx.display_clause_smt2(tout, *cls););
-                if (cls->is_lemma())
+                if (cls->is_lemma()) {
                     cls->inc_clause_activity();
+                    if (m_params.m_lemma_gc_tiered)
+                        m_ctx.update_lemma_tier(cls);
+                }
                 unsigned num_lits = cls->get_num_literals();
                 unsigned i        = 0;
                 if (consequent != false_literal) {
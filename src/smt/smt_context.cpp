@@ -17,6 +17,7 @@ Revision History:
 
 --*/
 #include<math.h>
+#include<fstream>
 #include "util/luby.h"
 #include "util/warning.h"
 #include "util/timeit.h"
@@ -28,6 +29,7 @@ Revision History:
 #include "ast/recfun_decl_plugin.h"
 #include "ast/proofs/proof_checker.h"
 #include "ast/ast_util.h"
+#include "ast/for_each_expr.h"
 #include "ast/well_sorted.h"
 #include "model/model.h"
 #include "model/model_pp.h"
@@ -68,6 +70,8 @@ namespace smt {
         m_final_check_idx(0),
         m_cg_table(m),
         m_units_to_reassert(m),
+        m_shared_lemmas(m),
+        m_var_hint_atoms(m),
         m_conflict(null_b_justification),
         m_not_l(null_literal),
         m_conflict_resolution(mk_conflict_resolution(m, *this, m_dyn_ack_manager, p, m_assigned_literals, m_watches)),
@@ -92,6 +96,9 @@ namespace smt {
             m_fparams.m_relevancy_lemma = false;
 
         m_model_generator->set_context(this);
+
+        if (m_fparams.m_profile)
+            m_profiler = alloc(profiler, m_assigned_literals);
     }
 
 
@@ -109,6 +116,8 @@ namespace smt {
         if (!m_setup.already_configured()) {
             m_fparams.updt_params(p);
         }
+        if (m_fparams.m_profile && !m_profiler)
+            m_profiler = alloc(profiler, m_assigned_literals);
     }
 
     unsigned context::relevancy_lvl() const {
@@ -173,7 +182,178 @@ namespace smt {
               dst_ctx.display(tout););
     }
 
+    void context::var_heuristics::filter(std::function<bool(expr*)> const& is_shared) {
+        unsigned j = 0;
+        for (expr * e : m_lemmas)
+            if (is_shared(e))
+                m_lemmas[j++] = e;
+        m_lemmas.shrink(j);
+    }
+
+    solver::phase * context::get_phase() {
+        var_heuristics * r = alloc(var_heuristics, this, m);
+        for (bool_var v = 0; v < get_num_bool_vars(); ++v) {
+            expr * e = bool_var2expr(v);
+            if (!e)
+                continue;
+            bool_var_data const & d = get_bdata(v);
+            lbool ph = get_assignment(v);
+            if (ph == l_undef && d.m_phase_available)
+                ph = to_lbool(d.m_phase);
+            if (ph == l_undef && m_activity[v] <= 0)
+                continue;
+            r->m_atoms.push_back(e);
+            r->m_activity.push_back(m_activity[v] / m_bvar_inc);
+            r->m_phase.push_back(ph);
+        }
+        if (m.proofs_enabled() || m_fparams.m_phase_transfer_lemma_size == 0)
+            return r;
+        // units and lemmas of the outermost scope, over atoms that can be copied.
+        auto is_safe = [&](literal l) {
+            bool_var_data const & d = get_bdata(l.var());
+            return !d.is_theory_atom() || m_theories.get_plugin(d.get_theory())->is_safe_to_copy(l.var());
+        };
+        for (literal lit : m_assigned_literals) {
+            if (get_assign_level(lit) > 0 || !is_safe(lit))
+                continue;
+            expr_ref fml(m);
+            literal2expr(lit, fml);
+            if (!has_skolem_functions(fml))
+                r->m_lemmas.push_back(fml);
+        }
+        unsigned num_lemmas = m_base_lvl == 0 ? m_lemmas.size() : m_base_scopes[0].m_lemmas_lim;
+        for (unsigned i = 0; i < num_lemmas; ++i) {
+            clause * cls = m_lemmas[i];
+            if (cls->deleted() || cls->get_num_literals() > m_fparams.m_phase_transfer_lemma_size || !std::all_of(cls->begin(), cls->end(), is_safe))
+                continue;
+            expr_ref_vector lits(m);
+            for (literal l : *cls)
+                lits.push_back(literal2expr(l));
+            expr_ref fml(mk_or(lits), m);
+            if (!has_skolem_functions(fml))
+                r->m_lemmas.push_back(fml);
+        }
+        return r;
+    }
+
+    void context::set_phase(solver::phase * p) {
+        var_heuristics * h = dynamic_cast<var_heuristics*>(p);
+        if (!h)
+            return;
+        m_var_hints.reset();
+        m_var_hint_atoms.reset();
+        for (unsigned i = 0; i < h->m_atoms.size(); ++i) {
+            expr * e = h->m_atoms.get(i);
+            var_hint hint = { h->m_activity[i] * m_bvar_inc, h->m_phase[i] };
+            if (b_internalized(e)) {
+                bool_var v = get_bool_var(e);
+                if (hint.m_phase != l_undef)
+                    force_phase(v, hint.m_phase == l_true);
+                if (hint.m_activity > m_activity[v]) {
+                    m_activity[v] = hint.m_activity;
+                    activity_changed(v, true);
+                }
+            }
+            else {
+                if (!m_var_hints.contains(e))
+                    m_var_hint_atoms.push_back(e);
+                m_var_hints.insert(e, hint);
+            }
+        }
+        if (h->m_source != this)
+            for (expr * fml : h->m_lemmas)
+                assert_expr(fml);
+    }
+
+    void context::get_snapshot(snapshot & s) {
+        pop_to_base_lvl();
+        if (m_asserted_formulas.get_macro_manager().get_num_macros() > 0)
+            throw default_exception("snapshots of contexts with eliminated macros are not supported");
+        s.reset();
+        s.m_logic = m_setup.get_logic();
+        // units and lemmas are not justified in the snapshot.
+        bool copy_derived = !m.proofs_enabled() && m_setup.already_configured();
+        auto is_safe = [&](literal l) {
+            bool_var_data const & d = get_bdata(l.var());
+            return !d.is_theory_atom() || m_theories.get_plugin(d.get_theory())->is_safe_to_copy(l.var());
+        };
+        svector<std::pair<unsigned, literal>> units;
+        for (literal lit : m_assigned_literals)
+            if (copy_derived && is_safe(lit))
+                units.push_back(std::make_pair(get_assign_level(lit), lit));
+        std::stable_sort(units.begin(), units.end(), [](auto const& a, auto const& b) { return a.first < b.first; });
+        unsigned fml_idx = 0, lemma_idx = 0, unit_idx = 0;
+        for (unsigned lvl = 0; lvl <= m_base_lvl; ++lvl) {
+            if (lvl > 0) {
+                s.m_fmls_lim.push_back(s.m_fmls.size());
+                s.m_lemmas_lim.push_back(s.m_lemmas.size());
+            }
+            unsigned fml_end = lvl < m_base_lvl ? m_asserted_formulas.get_formulas_lim(lvl) : m_asserted_formulas.get_num_formulas();
+            for (; fml_idx < fml_end; ++fml_idx) {
+                s.m_fmls.push_back(m_asserted_formulas.get_formula(fml_idx));
+                s.m_prs.push_back(m_asserted_formulas.get_formula_proof(fml_idx));
+            }
+            if (!copy_derived)
+                continue;
+            for (; unit_idx < units.size() && units[unit_idx].first <= lvl; ++unit_idx) {
+                expr_ref fml(m);
+                literal2expr(units[unit_idx].second, fml);
+                s.m_fmls.push_back(fml);
+                s.m_prs.push_back(nullptr);
+            }
+            unsigned lemma_end = lvl < m_base_lvl ? m_base_scopes[lvl].m_lemmas_lim : m_lemmas.size();
+            for (; lemma_idx < lemma_end; ++lemma_idx) {
+                clause * cls = m_lemmas[lemma_idx];
+                if (cls->deleted() || !std::all_of(cls->begin(), cls->end(), is_safe))
+                    continue;
+                expr_ref_vector lits(m);
+                for (literal l : *cls)
+                    lits.push_back(literal2expr(l));
+                s.m_lemmas.push_back(m.mk_app(m.get_basic_family_id(), OP_OR, lits.size(), lits.data()));
+            }
+        }
+    }
+
+    void context::restore(snapshot const & s) {
+        SASSERT(m_base_lvl == 0 && get_num_asserted_formulas() == 0);
+        if (s.m_logic != symbol::null)
+            set_logic(s.m_logic);
+        unsigned fml_idx = 0, lemma_idx = 0;
+        for (unsigned lvl = 0; lvl <= s.num_scopes(); ++lvl) {
+            if (lvl > 0)
+                push();
+            unsigned fml_end = lvl < s.num_scopes() ? s.m_fmls_lim[lvl] : s.m_fmls.size();
+            for (; fml_idx < fml_end; ++fml_idx)
+                assert_expr(s.m_fmls.get(fml_idx), s.m_prs.get(fml_idx));
+            unsigned lemma_end = lvl < s.num_scopes() ? s.m_lemmas_lim[lvl] : s.m_lemmas.size();
+            if (lemma_idx == lemma_end)
+                continue;
+            setup_context(m_fparams.m_auto_config);
+            internalize_assertions();
+            // lemmas are added as theory lemmas, so they remain subject to lemma garbage collection.
+            literal_buffer lits;
+            for (; lemma_idx < lemma_end && !inconsistent(); ++lemma_idx) {
+                lits.reset();
+                for (expr * arg : *to_app(s.m_lemmas.get(lemma_idx))) {
+                    expr * atom = arg;
+                    bool sign = m.is_not(arg, atom);
+                    internalize(atom, true);
+                    literal l = get_literal(atom);
+                    lits.push_back(sign ? ~l : l);
+                }
+                mk_clause(lits.size(), lits.data(), nullptr, CLS_TH_LEMMA);
+            }
+        }
+    }
+
     context::~context() {
+        if (m_profiler && !m_fparams.m_profile_file.empty()) {
+            std::ofstream out(m_fparams.m_profile_file, std::ios::app);
+            if (out)
+                m_profiler->display_folded(out);
+            else
+                IF_VERBOSE(0, verbose_stream() << "could not open file " << m_fparams.m_profile_file << " for output\n");
+        }
         flush();
         m_asserted_formulas.finalize();
     }
@@ -1276,6 +1456,14 @@ namespace smt {
         return r;
     }
 
+    /**
+       \brief Version of get_enode_eq_to for concurrent readers of the E-graph.
+       Each reader provides its own temporary enode.
+    */
+    enode * context::get_enode_eq_to(func_decl * f, unsigned num_args, enode * const * args, tmp_enode & tmp) const {
+        return m_cg_table.find_readonly(tmp.set(f, num_args, args));
+    }
+
     /**
        \brief Process the equality propagation queue.
 
@@ -1339,6 +1527,7 @@ namespace smt {
             else if (d.is_theory_atom()) {
                 theory * th = m_theories.get_plugin(d.get_theory());
                 SASSERT(th);
+                profiler::scope _ps(m_profiler.get(), th->get_name(), profiler::PROPAGATE);
                 th->assign_eh(v, val == l_true);                
             }
             else if (d.is_quantifier()) {
@@ -1608,6 +1797,7 @@ namespace smt {
 
     bool context::propagate_theories() {
         for (theory * t : m_theory_set) {
+            profiler::scope _ps(m_profiler.get(), t->get_name(), profiler::PROPAGATE);
             t->propagate();
             if (inconsistent())
                 return false;
@@ -1625,6 +1815,7 @@ namespace smt {
             new_th_eq curr = m_th_eq_propagation_queue[i];
             theory * th = get_theory(curr.m_th_id);
             SASSERT(th);
+            profiler::scope _ps(m_profiler.get(), th->get_name(), profiler::PROPAGATE);
             th->new_eq_eh(curr.m_lhs, curr.m_rhs);
             DEBUG_CODE(
                 push_trail(push_back_trail<new_th_eq, false>(m_propagated_th_eqs));
@@ -1638,6 +1829,7 @@ namespace smt {
             new_th_eq curr = m_th_diseq_propagation_queue[i];
             theory * th = get_theory(curr.m_th_id);
             SASSERT(th);
+            profiler::scope _ps(m_profiler.get(), th->get_name(), profiler::PROPAGATE);
             th->new_diseq_eh(curr.m_lhs, curr.m_rhs);
             DEBUG_CODE(
                 push_trail(push_back_trail<new_th_eq, false>(m_propagated_th_diseqs));
@@ -1711,6 +1903,7 @@ namespace smt {
             }
             if (!get_cancel_flag()) {
                 scoped_suspend_rlimit _suspend_cancel(m.limit(), at_base_level());
+                profiler::scope _ps(m_profiler.get(), "quantifiers", profiler::PROPAGATE);
                 m_qmanager->propagate();
             }
             if (inconsistent())
@@ -2704,6 +2897,8 @@ namespace smt {
     inline void context::del_inactive_lemmas() {
         if (m_fparams.m_lemma_gc_strategy == LGC_NONE)
             return;
+        else if (m_fparams.m_lemma_gc_tiered)
+            del_inactive_lemmas3();
         else if (m_fparams.m_lemma_gc_half)
             del_inactive_lemmas1();
         else
@@ -2819,6 +3014,78 @@ namespace smt {
         IF_VERBOSE(2, verbose_stream() << " :num-deleted-clauses " << num_del_cls << ")" << std::endl;);
     }
 
+    /**
+       \brief Tiered version of del_inactive_lemmas. Lemmas in the core tier are kept.
+       Lemmas in tier2 that were not used in conflicts since the last garbage collection
+       are moved to the local tier. Half of the unused local lemmas, those with the largest
+       glue and lowest activity, are deleted. Recent lemmas are not touched.
+    */
+    void context::del_inactive_lemmas3() {
+        unsigned sz            = m_lemmas.size();
+        unsigned start_at      = m_base_lvl == 0 ? 0 : m_base_scopes[m_base_lvl - 1].m_lemmas_lim;
+        SASSERT(start_at <= sz);
+        if (start_at + m_fparams.m_recent_lemmas_size >= sz)
+            return;
+        IF_VERBOSE(2, verbose_stream() << "(smt.delete-inactive-lemmas"; verbose_stream().flush(););
+        unsigned end_at        = sz - m_fparams.m_recent_lemmas_size;
+        auto is_candidate = [&](clause * cls) {
+            return cls->get_tier() == LT_LOCAL && !cls->is_used();
+        };
+        // candidates are moved to the end, the ones with the largest glue and lowest activity last.
+        std::stable_sort(m_lemmas.begin() + start_at, m_lemmas.begin() + end_at, [&](clause * c1, clause * c2) {
+            bool d1 = is_candidate(c1), d2 = is_candidate(c2);
+            if (d1 != d2)
+                return d2;
+            if (!d1)
+                return false;
+            if (c1->get_glue() != c2->get_glue())
+                return c1->get_glue() < c2->get_glue();
+            return c1->get_activity() > c2->get_activity();
+        });
+        unsigned num_candidates = 0;
+        for (unsigned i = start_at; i < end_at; i++)
+            if (is_candidate(m_lemmas[i]))
+                num_candidates++;
+        unsigned start_del_at  = end_at - num_candidates / 2;
+        unsigned j             = start_at;
+        unsigned num_del_cls   = 0;
+        unsigned num_core      = 0;
+        for (unsigned i = start_at; i < sz; i++) {
+            clause * cls = m_lemmas[i];
+            if ((cls->deleted() || (start_del_at <= i && i < end_at)) && can_delete(cls)) {
+                if (!cls->deleted())
+                    m_stats.m_num_del_inactive_lemmas++;
+                del_clause(true, cls);
+                num_del_cls++;
+                continue;
+            }
+            if (i < end_at) {
+                if (cls->get_tier() == LT_CORE)
+                    num_core++;
+                else if (cls->get_tier() == LT_TIER2 && !cls->is_used())
+                    cls->set_tier(LT_LOCAL);
+                cls->set_used(false);
+            }
+            m_lemmas[j++] = cls;
+        }
+        m_lemmas.shrink(j);
+        IF_VERBOSE(2, verbose_stream() << " :num-deleted-clauses " << num_del_cls << " :num-core-clauses " << num_core << ")" << std::endl;);
+    }
+
+    /**
+       \brief Record that the lemma cls was used in a conflict. Its glue is recomputed
+       and the lemma is promoted to a better tier if the glue decreased.
+    */
+    void context::update_lemma_tier(clause * cls) {
+        SASSERT(cls->is_lemma());
+        cls->set_used(true);
+        if (cls->get_tier() == LT_CORE)
+            return;
+        unsigned glue = get_glue(cls->get_num_literals(), cls->begin());
+        if (glue < cls->get_glue())
+            set_lemma_tier(cls, glue);
+    }
+
     /**
        \brief Return true if "cls" has more than (or equal to) k unassigned literals.
     */
@@ -3909,7 +4176,11 @@ namespace smt {
         m_stats.m_num_final_checks++;
         TRACE("final_check_stats", tout << "m_stats.m_num_final_checks = " << m_stats.m_num_final_checks << "\n";);
 
-        final_check_status ok = m_qmanager->final_check_eh(false);
+        final_check_status ok;
+        {
+            profiler::scope _ps(m_profiler.get(), "quantifiers", profiler::FINAL_CHECK);
+            ok = m_qmanager->final_check_eh(false);
+        }
         if (ok != FC_DONE)
             return ok;
 
@@ -3927,6 +4198,7 @@ namespace smt {
             if (m_final_check_idx < num_th) {
                 theory * th = m_theory_set[m_final_check_idx];
                 IF_VERBOSE(100, verbose_stream() << "(smt.final-check \"" << th->get_name() << "\")\n";);
+                profiler::scope _ps(m_profiler.get(), th->get_name(), profiler::FINAL_CHECK);
                 ok = th->final_check_eh();
                 TRACE("final_check_step", tout << "final check '" << th->get_name() << " ok: " << ok << " inconsistent " << inconsistent() << "\n";);
                 if (ok == FC_GIVEUP) {
@@ -3935,6 +4207,7 @@ namespace smt {
                 }
             }
             else {
+                profiler::scope _ps(m_profiler.get(), "quantifiers", profiler::FINAL_CHECK);
                 ok = m_qmanager->final_check_eh(true);
                 TRACE("final_check_step", tout << "quantifier  ok: " << ok << " " << "inconsistent " << inconsistent() << "\n";);
             }
@@ -3989,7 +4262,21 @@ namespace smt {
     }
 
 
+    /**
+       \brief Return the name of the theory that detected the current conflict,
+       or "core" if the conflict was detected by the core.
+    */
+    char const * context::get_conflict_source() const {
+        if (m_conflict.get_kind() == b_justification::JUSTIFICATION) {
+            theory * th = get_theory(m_conflict.get_justification()->get_from_theory());
+            if (th)
+                return th->get_name();
+        }
+        return "core";
+    }
+
     bool context::resolve_conflict() {
+        profiler::scope _ps(m_profiler.get(), m_profiler ? get_conflict_source() : nullptr, profiler::CONFLICT);
         m_stats.m_num_conflicts++;
         m_num_conflicts ++;
         m_num_conflicts_since_restart ++;
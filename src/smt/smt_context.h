@@ -37,6 +37,8 @@ Revision History:
 #include "smt/smt_case_split_queue.h"
 #include "smt/smt_almost_cg_table.h"
 #include "smt/smt_failure.h"
+#include "smt/smt_snapshot.h"
+#include "smt/smt_profiler.h"
 #include "smt/smt_types.h"
 #include "smt/dyn_ack.h"
 #include "ast/ast_smt_pp.h"
@@ -50,6 +52,7 @@ Revision History:
 #include "smt/user_propagator.h"
 #include "model/model.h"
 #include "solver/progress_callback.h"
+#include "solver/solver.h"
 #include "solver/assertions/asserted_formulas.h"
 #include <tuple>
 
@@ -177,6 +180,16 @@ namespace smt {
         vector<clause_vector>       m_clauses_to_reinit;
         expr_ref_vector             m_units_to_reassert;
         svector<char>               m_units_to_reassert_sign;
+        bool                        m_collect_shared_lemmas { false }; //!< set by parallel contexts that exchange lemmas
+        expr_ref_vector             m_shared_lemmas;  //!< short lemmas of low glue, exported to other parallel contexts
+        struct var_hint {
+            double m_activity;
+            lbool  m_phase;
+        };
+        obj_map<expr, var_hint>     m_var_hints;      //!< inherited phases and activities of atoms, consumed when the atoms are internalized
+        expr_ref_vector             m_var_hint_atoms;
+        unsigned_vector             m_glue_marks;     //!< scope level -> stamp, used to compute the glue of lemmas
+        unsigned                    m_glue_stamp { 0 };
         literal_vector              m_assigned_literals;
         typedef std::pair<clause*, literal_vector> tmp_clause;
         vector<tmp_clause>          m_tmp_clauses;
@@ -185,6 +198,7 @@ namespace smt {
         int                         m_simp_counter { 0 }; //!< can become negative
         scoped_ptr<case_split_queue> m_case_split_queue;
         scoped_ptr<induction>       m_induction;
+        scoped_ptr<profiler>        m_profiler;       //!< only allocated if smt.profile is set
         double                      m_bvar_inc { 1.0 };
         bool                        m_phase_cache_on { true };
         unsigned                    m_phase_counter { 0 }; //!< auxiliary variable used to decide when to turn on/off phase caching
@@ -884,8 +898,16 @@ namespace smt {
         void remove_lit_occs(clause const& cls, unsigned num_bool_vars);
 
         void add_lit_occs(clause const& cls);
+
+        unsigned get_glue(unsigned num_lits, literal const* lits);
+
+        void set_lemma_tier(clause * cls, unsigned glue);
+
+        void collect_shared_lemma(unsigned num_lits, literal const* lits, unsigned glue);
     public:        
 
+        void update_lemma_tier(clause * cls);
+
         void ensure_internalized(expr* e);
 
         void internalize(expr * n, bool gate_ctx);
@@ -1048,6 +1070,8 @@ namespace smt {
 
         void set_global_generation(unsigned generation) { m_generation = generation; }
 
+        fingerprint_set const & get_fingerprints() const { return m_fingerprints; }
+
 #ifdef Z3DEBUG
         bool slow_contains_instance(quantifier const * q, unsigned num_bindings, enode * const * bindings) const {
             return m_fingerprints.slow_contains(q, q->get_id(), num_bindings, bindings);
@@ -1132,6 +1156,8 @@ namespace smt {
 
         enode * get_enode_eq_to(func_decl * f, unsigned num_args, enode * const * args);
 
+        enode * get_enode_eq_to(func_decl * f, unsigned num_args, enode * const * args, tmp_enode & tmp) const;
+
     protected:
         bool decide();
 
@@ -1189,6 +1215,8 @@ namespace smt {
 
         void del_inactive_lemmas2();
 
+        void del_inactive_lemmas3();
+
         bool more_than_k_unassigned_literals(clause * cls, unsigned k);
 
         void internalize_assertions();
@@ -1235,6 +1263,8 @@ namespace smt {
 
         void forget_phase_of_vars_in_current_level();
 
+        char const * get_conflict_source() const;
+
         virtual bool resolve_conflict();
 
 
@@ -1595,6 +1625,39 @@ namespace smt {
 
         static void copy(context& src, context& dst, bool override_base = false);
 
+        /**
+           \brief Phases and activities of atoms, and the units and lemmas with at most
+           smt.phase_transfer.lemma_size literals derived before the first user scope.
+           Phases and activities of atoms that are not internalized are applied when
+           the atoms are internalized. Units and lemmas are only transferred to other contexts.
+        */
+        class var_heuristics : public solver::phase {
+            friend class context;
+            context const * m_source;
+            expr_ref_vector m_atoms;
+            svector<double> m_activity; // normalized by the activity increment of the source
+            svector<lbool>  m_phase;
+            expr_ref_vector m_lemmas;
+        public:
+            var_heuristics(context const * src, ast_manager & m): m_source(src), m_atoms(m), m_lemmas(m) {}
+            void filter(std::function<bool(expr*)> const& is_shared) override;
+        };
+
+        solver::phase * get_phase();
+
+        void set_phase(solver::phase * p);
+
+        /**
+           \brief Capture the assertions of every user scope, and the units and lemmas
+           derived in the scope, in s. The context is backtracked to the base level first.
+        */
+        void get_snapshot(snapshot & s);
+
+        /**
+           \brief Assert the formulas of the snapshot s into a fresh context, re-creating its user scopes.
+        */
+        void restore(snapshot const & s);
+
         /**
            \brief Translate context to use new manager m.
          */
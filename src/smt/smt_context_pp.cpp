@@ -397,6 +397,7 @@ namespace smt {
         st.update("added eqs", m_stats.m_num_add_eq);
         st.update("mk clause", m_stats.m_num_mk_clause);
         st.update("del clause", m_stats.m_num_del_clause);
+        st.update("del inactive lemmas", m_stats.m_num_del_inactive_lemmas);
         st.update("dyn ack", m_stats.m_num_dyn_ack);
         st.update("interface eqs", m_stats.m_num_interface_eqs);
         st.update("max generation", m_stats.m_max_generation);
@@ -408,6 +409,8 @@ namespace smt {
         for (theory* th : m_theory_set) {
             th->collect_statistics(st);
         }
+        if (m_profiler)
+            m_profiler->collect_statistics(st);
     }
 
     void context::display_statistics(std::ostream & out) const {
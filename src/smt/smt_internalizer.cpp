@@ -490,8 +490,13 @@ namespace smt {
         SASSERT(!b_internalized(n));
         theory * th  = m_theories.get_plugin(n->get_family_id());
         TRACE("datatype_bug", tout << "internalizing theory atom:\n" << mk_pp(n, m) << "\n";);
-        if (!th || !th->internalize_atom(n, gate_ctx))
+        if (!th)
             return false;
+        {
+            profiler::scope _ps(m_profiler.get(), th->get_name(), profiler::INTERNALIZE);
+            if (!th->internalize_atom(n, gate_ctx))
+                return false;
+        }
         TRACE("datatype_bug", tout << "internalization succeeded\n" << mk_pp(n, m) << "\n";);
         SASSERT(b_internalized(n));
         TRACE("internalize_theory_atom", tout << "internalizing theory atom: #" << n->get_id() << "\n";);
@@ -799,8 +804,10 @@ namespace smt {
                 //   Now, (* 2 x) is not internal to arithmetic anymore,
                 //   and a theory variable must be created for it.
                 enode * e = get_enode(n);
-                if (!th->is_attached_to_var(e))
+                if (!th->is_attached_to_var(e)) {
+                    profiler::scope _ps(m_profiler.get(), th->get_name(), profiler::INTERNALIZE);
                     th->internalize_term(n);
+                }
             }
             return;
         }
@@ -870,9 +877,10 @@ namespace smt {
     */
     bool context::internalize_theory_term(app * n) {
         theory * th  = m_theories.get_plugin(n->get_family_id());
-        if (!th || !th->internalize_term(n))
+        if (!th)
             return false;
-        return true;
+        profiler::scope _ps(m_profiler.get(), th->get_name(), profiler::INTERNALIZE);
+        return th->internalize_term(n);
     }
 
     /**
@@ -928,6 +936,17 @@ namespace smt {
             m_activity[v]      = -((m_random() % 1000) / 1000.0); 
         else
             m_activity[v]      = 0.0;
+        var_hint hint;
+        if (!m_var_hints.empty() && m_var_hints.find(n, hint)) {
+            m_activity[v] = std::max(m_activity[v], hint.m_activity);
+            if (hint.m_phase != l_undef) {
+                data.m_phase_available = true;
+                data.m_phase = hint.m_phase == l_true;
+            }
+            m_var_hints.erase(n);
+            if (m_var_hints.empty())
+                m_var_hint_atoms.reset();
+        }
         m_case_split_queue->mk_var_eh(v);
         m_b_internalized_stack.push_back(n);
         m_trail_stack.push_back(&m_mk_bool_var_trail);
@@ -1349,6 +1368,59 @@ namespace smt {
         CASSERT("watch_list", check_watch_list(l_idx));
     }
 
+    /**
+       \brief Return the number of distinct decision levels above the base level among the
+       assigned literals. Unassigned literals count as one additional level.
+    */
+    unsigned context::get_glue(unsigned num_lits, literal const* lits) {
+        if (++m_glue_stamp == 0) {
+            m_glue_marks.reset();
+            m_glue_stamp = 1;
+        }
+        unsigned glue = 0;
+        bool has_undef = false;
+        for (unsigned i = 0; i < num_lits; ++i) {
+            literal l = lits[i];
+            if (get_assignment(l) == l_undef) {
+                has_undef = true;
+                continue;
+            }
+            unsigned lvl = get_assign_level(l);
+            if (lvl <= m_base_lvl)
+                continue;
+            m_glue_marks.reserve(lvl + 1, 0);
+            if (m_glue_marks[lvl] != m_glue_stamp) {
+                m_glue_marks[lvl] = m_glue_stamp;
+                ++glue;
+            }
+        }
+        return has_undef ? glue + 1 : glue;
+    }
+
+    void context::set_lemma_tier(clause * cls, unsigned glue) {
+        cls->set_glue(glue);
+        if (glue <= m_fparams.m_lemma_gc_tier1_glue)
+            cls->set_tier(LT_CORE);
+        else if (glue <= m_fparams.m_lemma_gc_tier2_glue)
+            cls->set_tier(LT_TIER2);
+        else
+            cls->set_tier(LT_LOCAL);
+    }
+
+    /**
+       \brief Record a lemma for exchange with other parallel contexts if it is short 
+       and its glue, the number of distinct decision levels among its literals, is low.
+       Literals assigned at base level do not count towards the glue.
+    */
+    void context::collect_shared_lemma(unsigned num_lits, literal const* lits, unsigned glue) {
+        if (num_lits > m_fparams.m_threads_share_size || glue > m_fparams.m_threads_share_glue)
+            return;
+        expr_ref_vector fmls(m);
+        for (unsigned i = 0; i < num_lits; ++i)
+            fmls.push_back(literal2expr(lits[i]));
+        m_shared_lemmas.push_back(m.mk_or(fmls));
+    }
+
     /**
        \brief Create a new clause using the given literals, justification, kind and deletion event handler.
        The deletion event handler is ignored if binary clause optimization is applicable.
@@ -1389,6 +1461,12 @@ namespace smt {
         }
         TRACE("mk_clause", display_literals_verbose(tout << "after simplification:\n", num_lits, lits) << "\n";);
 
+        unsigned glue = 0;
+        if (is_lemma(k) && num_lits > 1 && (m_collect_shared_lemmas || m_fparams.m_lemma_gc_tiered))
+            glue = get_glue(num_lits, lits);
+        if (m_collect_shared_lemmas && is_lemma(k) && num_lits > 1)
+            collect_shared_lemma(num_lits, lits, glue);
+
         unsigned activity = 1;
         bool  lemma = is_lemma(k);
         m_stats.m_num_mk_lits += num_lits;
@@ -1433,6 +1511,8 @@ namespace smt {
             m_clause_proof.add(*cls);
             if (lemma) {
                 cls->set_activity(activity);
+                if (m_fparams.m_lemma_gc_tiered)
+                    set_lemma_tier(cls, glue);
                 if (k == CLS_LEARNED) {
                     int w2_idx  = select_learned_watch_lit(cls);
                     cls->swap_lits(1, w2_idx);
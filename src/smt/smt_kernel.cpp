@@ -267,6 +267,23 @@ namespace smt {
         imp::copy(*src.m_imp, *dst.m_imp);
     }
 
+    solver::phase* kernel::get_phase() {
+        return m_imp->m_kernel.get_phase();
+    }
+
+    void kernel::set_phase(solver::phase* p) {
+        m_imp->m_kernel.set_phase(p);
+    }
+
+    void kernel::get_snapshot(snapshot & s) {
+        m_imp->m_kernel.get_snapshot(s);
+    }
+
+    void kernel::restore(snapshot const & s) {
+        reset();
+        m_imp->m_kernel.restore(s);
+    }
+
     bool kernel::set_logic(symbol logic) {
         return m_imp->set_logic(logic);
     }
@@ -41,6 +41,7 @@ namespace smt {
 
     class enode;
     class context;
+    class snapshot;
     
     class kernel {
         struct imp;
@@ -52,6 +53,23 @@ namespace smt {
 
         static void copy(kernel& src, kernel& dst);
 
+        /**
+           \brief Capture the assertions and user scopes of the kernel, together with derived units and lemmas.
+           The kernel can be reset to the snapshot using restore, also after the scopes of the snapshot were popped.
+
+           \remark The kernel is backtracked to the base level (pop_to_base_lvl), so the current
+           assignment and the model of the last check are lost.
+
+           \remark Snapshots are only available on the kernel, the solver interface (smt_solver) does not
+           expose them: it keeps its own stack of assumption scopes, which restore would not re-create.
+        */
+        void get_snapshot(snapshot & s);
+
+        /**
+           \brief Reset the kernel to the state captured by the snapshot s.
+        */
+        void restore(snapshot const & s);
+
         ast_manager & m() const;
         
         /**
@@ -152,11 +170,16 @@ namespace smt {
 
         /**
            \brief control phase selection and variable ordering.
-           Base implementation is a no-op.
+           Setting the phase of individual atoms and moving them to the front is a no-op.
         */
         void set_phase(expr * e) { }
-        solver::phase* get_phase() { return nullptr; }
-        void set_phase(solver::phase* p) { }
+        
+        /**
+           \brief Return the phases and activities of atoms, and the units and short lemmas
+           learned at base level. They can be used to warm start kernels over the same atoms.
+        */
+        solver::phase* get_phase();
+        void set_phase(solver::phase* p);
         void move_to_front(expr* e) { }
 
         /**
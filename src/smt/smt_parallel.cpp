@@ -21,6 +21,7 @@ Author:
 #include "ast/ast_pp.h"
 #include "ast/ast_ll_pp.h"
 #include "ast/ast_translation.h"
+#include "ast/for_each_expr.h"
 #include "smt/smt_parallel.h"
 #include "smt/smt_lookahead.h"
 
@@ -87,6 +88,7 @@ namespace smt {
             context& new_ctx = *pctxs.back();
             context::copy(ctx, new_ctx, true);
             new_ctx.set_random_seed(i + ctx.get_fparams().m_random_seed);
+            new_ctx.m_collect_shared_lemmas = ctx.get_fparams().m_threads_share_glue > 0;
             ast_translation tr(m, *new_m);
             pasms.push_back(tr(asms));
             sl.push_child(&(new_m->limit()));
@@ -107,6 +109,47 @@ namespace smt {
         unsigned_vector unit_lim;
         for (unsigned i = 0; i < num_threads; ++i) unit_lim.push_back(0);
 
+        obj_hashtable<expr> lemma_set;
+        expr_ref_vector lemma_trail(ctx.m);
+        unsigned_vector lemma_source;
+        unsigned_vector lemma_lim(num_threads, 0u);
+        unsigned num_shared_lemmas = 0;
+
+        // Exchange short lemmas of low glue that were learned by the contexts in the last round.
+        // Lemmas that mention skolem functions are local to the context that introduced them.
+        std::function<void(void)> collect_lemmas = [&,this]() {
+            for (unsigned i = 0; i < num_threads; ++i) {
+                context& pctx = *pctxs[i];
+                ast_translation tr(pctx.m, ctx.m);
+                for (expr* e : pctx.m_shared_lemmas) {
+                    if (has_skolem_functions(e)) 
+                        continue;
+                    expr_ref ce(tr(e), ctx.m);
+                    if (!lemma_set.contains(ce)) {
+                        lemma_set.insert(ce);
+                        lemma_trail.push_back(ce);
+                        lemma_source.push_back(i);
+                    }
+                }
+                pctx.m_shared_lemmas.reset();
+            }
+
+            unsigned sz = lemma_trail.size();
+            for (unsigned i = 0; i < num_threads; ++i) {
+                context& pctx = *pctxs[i];
+                ast_translation tr(ctx.m, pctx.m);
+                for (unsigned j = lemma_lim[i]; j < sz; ++j) {
+                    if (lemma_source[j] == i)
+                        continue;
+                    expr_ref dst(tr(lemma_trail.get(j)), pctx.m);
+                    pctx.assert_expr(dst);
+                    ++num_shared_lemmas;
+                }
+                lemma_lim[i] = sz;
+            }
+            IF_VERBOSE(1, verbose_stream() << "(smt.thread :lemmas " << sz << ")\n");
+        };
+
         std::function<void(void)> collect_units = [&,this]() {
             for (unsigned i = 0; i < num_threads; ++i) {
                 context& pctx = *pctxs[i];
@@ -228,6 +271,7 @@ namespace smt {
             if (done) break;
 
             collect_units();
+            collect_lemmas();
             ++num_rounds;
             max_conflicts = (max_conflicts < thread_max_conflicts) ? 0 : (max_conflicts - thread_max_conflicts);
             thread_max_conflicts *= 2;            
@@ -236,6 +280,7 @@ namespace smt {
         for (context* c : pctxs) {
             c->collect_statistics(ctx.m_aux_stats);
         }
+        ctx.m_aux_stats.update("smt parallel shared lemmas", num_shared_lemmas);
 
         if (finished_id == UINT_MAX) {
             switch (ex_kind) {
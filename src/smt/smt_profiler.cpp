@@ -0,0 +1,113 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    smt_profiler.cpp
+
+Abstract:
+
+    Opt-in profiler for the theory solvers of an SMT context.
+
+Revision History:
+
+--*/
+#include "util/symbol.h"
+#include "smt/smt_profiler.h"
+#include <cstring>
+
+namespace smt {
+
+    profiler::profiler(literal_vector const & assigned):
+        m_assigned(assigned),
+        m_last(clock::now()) {
+        m_nodes.push_back(node(0, "smt", PROPAGATE));
+    }
+
+    char const * profiler::kind2str(kind k) {
+        switch (k) {
+        case PROPAGATE:   return "propagate";
+        case FINAL_CHECK: return "final_check";
+        case INTERNALIZE: return "internalize";
+        case CONFLICT:    return "conflict";
+        default:          return "?";
+        }
+    }
+
+    unsigned profiler::enter(char const * name, kind k) {
+        charge();
+        for (unsigned c : m_nodes[m_current].m_children) {
+            node & n = m_nodes[c];
+            if (n.m_kind == k && n.m_name == name) {
+                n.m_calls++;
+                m_current = c;
+                return c;
+            }
+        }
+        unsigned c = m_nodes.size();
+        m_nodes.push_back(node(m_current, name, k));
+        m_nodes[m_current].m_children.push_back(c);
+        m_nodes[c].m_calls++;
+        m_current = c;
+        return c;
+    }
+
+    void profiler::collect_statistics(::statistics & st) const {
+        struct entry {
+            char const * m_name;
+            kind         m_kind;
+            double       m_seconds;
+            unsigned     m_calls;
+            unsigned     m_propagations;
+        };
+        svector<entry> entries;
+        for (unsigned i = 1; i < m_nodes.size(); ++i) {
+            node const & n = m_nodes[i];
+            double secs = std::chrono::duration<double>(n.m_self).count();
+            bool found = false;
+            for (entry & e : entries) {
+                if (e.m_kind == n.m_kind && strcmp(e.m_name, n.m_name) == 0) {
+                    e.m_seconds += secs;
+                    e.m_calls += n.m_calls;
+                    e.m_propagations += n.m_propagations;
+                    found = true;
+                    break;
+                }
+            }
+            if (!found)
+                entries.push_back({ n.m_name, n.m_kind, secs, n.m_calls, n.m_propagations });
+        }
+        // statistics keep pointers to their keys, so they are interned as symbols.
+        auto mk_key = [](char const * prefix, entry const & e, char const * suffix) {
+            std::string key = std::string(prefix) + e.m_name + "." + kind2str(e.m_kind) + suffix;
+            return symbol(key).bare_str();
+        };
+        for (entry const & e : entries) {
+            st.update(mk_key("time.smt.", e, ""), e.m_seconds);
+            st.update(mk_key("smt.", e, ".calls"), e.m_calls);
+            if (e.m_kind != INTERNALIZE && e.m_propagations > 0)
+                st.update(mk_key("smt.", e, ".propagations"), e.m_propagations);
+        }
+    }
+
+    void profiler::display_stack(std::ostream & out, unsigned n) const {
+        if (n != 0) {
+            display_stack(out, m_nodes[n].m_parent);
+            out << ";" << m_nodes[n].m_name << "." << kind2str(m_nodes[n].m_kind);
+        }
+        else {
+            out << m_nodes[0].m_name;
+        }
+    }
+
+    void profiler::display_folded(std::ostream & out) const {
+        for (unsigned i = 1; i < m_nodes.size(); ++i) {
+            auto us = std::chrono::duration_cast<std::chrono::microseconds>(m_nodes[i].m_self).count();
+            if (us == 0)
+                continue;
+            display_stack(out, i);
+            out << " " << us << "\n";
+        }
+    }
+
+};
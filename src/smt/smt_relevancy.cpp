@@ -131,8 +131,10 @@ namespace smt {
         expr_ref_vector                m_relevant_exprs; 
         uint_set                       m_is_relevant;
         typedef list<relevancy_eh *>   relevancy_ehs;
-        obj_map<expr, relevancy_ehs *> m_relevant_ehs;
-        obj_map<expr, relevancy_ehs *> m_watches[2];
+        // handlers and watches are indexed by expression id. 
+        // Expressions in these tables are kept alive by m_trail.
+        ptr_vector<relevancy_ehs>      m_relevant_ehs;
+        ptr_vector<relevancy_ehs>      m_watches[2];
         struct eh_trail {
             enum kind { POS_WATCH, NEG_WATCH, HANDLER };
             kind   m_kind;
@@ -158,32 +160,35 @@ namespace smt {
             undo_trail(0);
         }
 
+        static relevancy_ehs * get(ptr_vector<relevancy_ehs> const & table, expr * n) {
+            unsigned id = n->get_id();
+            return id < table.size() ? table[id] : nullptr;
+        }
+
+        static void set(ptr_vector<relevancy_ehs> & table, expr * n, relevancy_ehs * ehs) {
+            unsigned id = n->get_id();
+            if (id >= table.size()) {
+                if (ehs == nullptr)
+                    return;
+                table.resize(id + 1, nullptr);
+            }
+            table[id] = ehs;
+        }
+
         relevancy_ehs * get_handlers(expr * n) {
-            relevancy_ehs * r = nullptr;
-            m_relevant_ehs.find(n, r);
-            SASSERT(m_relevant_ehs.contains(n) || r == 0);
-            return r;
+            return get(m_relevant_ehs, n);
         }
 
         void set_handlers(expr * n, relevancy_ehs * ehs) {
-            if (ehs == nullptr)
-                m_relevant_ehs.erase(n);
-            else
-                m_relevant_ehs.insert(n, ehs);
+            set(m_relevant_ehs, n, ehs);
         }
 
         relevancy_ehs * get_watches(expr * n, bool val) {
-            relevancy_ehs * r = nullptr;
-            m_watches[val ? 1 : 0].find(n, r);
-            SASSERT(m_watches[val ? 1 : 0].contains(n) || r == 0);
-            return r;
+            return get(m_watches[val ? 1 : 0], n);
         }
 
         void set_watches(expr * n, bool val, relevancy_ehs * ehs) {
-            if (ehs == nullptr)
-                m_watches[val ? 1 : 0].erase(n);
-            else
-                m_watches[val ? 1 : 0].insert(n, ehs);
+            set(m_watches[val ? 1 : 0], n, ehs);
         }
 
         void push_trail(eh_trail const & t) {
@@ -0,0 +1,65 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    smt_snapshot.h
+
+Abstract:
+
+    Snapshot of the logical state of an SMT context.
+
+    A snapshot stores the preprocessed assertions of every user scope,
+    together with the units and lemmas that were derived in the scope.
+    A context can be reset to a snapshot, also after the scopes of the
+    snapshot were popped. Expressions are hash-consed by the ast_manager,
+    so snapshots share formulas with the context and with each other.
+
+Revision History:
+
+--*/
+#pragma once
+
+#include "ast/ast.h"
+#include "util/ref.h"
+
+namespace smt {
+
+    class context;
+
+    class snapshot {
+        friend class context;
+        unsigned          m_ref_count { 0 };
+        symbol            m_logic;
+        expr_ref_vector   m_fmls;       // assertions and units
+        proof_ref_vector  m_prs;        // proofs of assertions, if proofs are enabled
+        expr_ref_vector   m_lemmas;     // disjunctions of lemma literals
+        unsigned_vector   m_fmls_lim;   // m_fmls_lim[i] is the number of formulas before user scope i+1
+        unsigned_vector   m_lemmas_lim; // m_lemmas_lim[i] is the number of lemmas before user scope i+1
+    public:
+        snapshot(ast_manager & m): m_fmls(m), m_prs(m), m_lemmas(m) {}
+
+        void inc_ref() { ++m_ref_count; }
+        void dec_ref() { SASSERT(m_ref_count > 0); if (--m_ref_count == 0) dealloc(this); }
+
+        void reset() {
+            m_logic = symbol::null;
+            m_fmls.reset();
+            m_prs.reset();
+            m_lemmas.reset();
+            m_fmls_lim.reset();
+            m_lemmas_lim.reset();
+        }
+
+        /**
+           \brief Return the number of user scopes captured by the snapshot.
+        */
+        unsigned num_scopes() const { return m_fmls_lim.size(); }
+
+        unsigned num_formulas() const { return m_fmls.size(); }
+
+        unsigned num_lemmas() const { return m_lemmas.size(); }
+    };
+
+    typedef ref<snapshot> snapshot_ref;
+};
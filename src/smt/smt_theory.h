@@ -585,7 +585,11 @@ namespace smt {
             return false;
         }
 
-        virtual char const * get_name() const { return "unknown"; }
+        /**
+           \brief Name of the theory in statistics, traces and profiles.
+           By default the name of the family of the theory.
+        */
+        virtual char const * get_name() const { return m.get_family_name(get_family_id()).bare_str(); }
 
         // -----------------------------------
         //
@@ -253,6 +253,8 @@ public:
     void reduce();
     unsigned get_num_formulas() const { return m_formulas.size(); }
     unsigned get_formulas_last_level() const;
+    // number of formulas asserted before user scope lvl+1 was created.
+    unsigned get_formulas_lim(unsigned lvl) const { return lvl < m_scopes.size() ? m_scopes[lvl].m_formulas_lim : m_formulas.size(); }
     unsigned get_qhead() const { return m_qhead; }
     void commit(); 
     void commit(unsigned new_qhead); 
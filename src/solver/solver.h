@@ -21,6 +21,7 @@ Notes:
 #include "solver/check_sat_result.h"
 #include "solver/progress_callback.h"
 #include "util/params.h"
+#include <functional>
 
 class solver;
 class model_converter;
@@ -114,7 +115,15 @@ public:
     virtual void set_phase(expr* e) = 0;
     virtual void move_to_front(expr* e) = 0; 
 
-    class phase { public: virtual ~phase() {} };
+    class phase { 
+    public: 
+        virtual ~phase() {} 
+        /**
+           \brief Drop learned formulas that do not satisfy is_shared before the phase is
+           transferred to a solver with different assertions.
+        */
+        virtual void filter(std::function<bool(expr*)> const& is_shared) {}
+    };
     
     virtual phase* get_phase() = 0;
 
@@ -21,6 +21,7 @@ Notes:
 #include "solver/solver_na2as.h"
 #include "ast/proofs/proof_utils.h"
 #include "ast/ast_util.h"
+#include "ast/for_each_expr.h"
 
 class pool_solver : public solver_na2as {
     solver_pool&       m_pool;
@@ -364,6 +365,7 @@ void solver_pool::collect_statistics(statistics &st) const {
     st.update("pool_solver.checks", m_stats.m_num_checks);
     st.update("pool_solver.checks.sat", m_stats.m_num_sat_checks);
     st.update("pool_solver.checks.undef", m_stats.m_num_undef_checks);
+    st.update("pool_solver.inherited", m_stats.m_num_inherited);
 }
 
 void solver_pool::reset_statistics() {
@@ -392,6 +394,10 @@ solver* solver_pool::mk_solver() {
     ast_manager& m = m_base_solver->get_manager();
     if (m_solvers.size() < m_num_pools) {
         base_solver = m_base_solver->translate(m, m_base_solver->get_params());
+        if (m_heuristics) {
+            base_solver->set_phase(m_heuristics.get());
+            m_stats.m_num_inherited++;
+        }
     }
     else {
         solver* s = m_solvers[(m_current_pool++) % m_num_pools];
@@ -401,6 +407,7 @@ solver* solver_pool::mk_solver() {
     name << "vsolver#" << m_solvers.size();
     app_ref pred(m.mk_const(symbol(name.str()), m.mk_bool_sort()), m);
     pool_solver* solver = alloc(pool_solver, base_solver.get(), *this, pred);
+    m_preds.insert(pred->get_decl());
     m_solvers.push_back(solver);
     return solver;
 }
@@ -411,9 +418,35 @@ void solver_pool::reset_solver(solver* s) {
     if (ps) ps->reset();
 }
 
+/**
+   \brief Formulas learned by a base solver can be transferred to other
+   base solvers if they do not mention the predicates that guard the
+   assertions of pool solvers.
+*/
+bool solver_pool::is_shared(expr* e) const {
+    ast_manager& m = m_base_solver->get_manager();
+    for (expr* t : subterms(expr_ref(e, m))) 
+        if (is_app(t) && m_preds.contains(to_app(t)->get_decl()))
+            return false;
+    return true;
+}
+
+/**
+   \brief Replace base_solver by a fresh base solver.
+   The fresh base solver inherits the phases and activities of the atoms of
+   base_solver and the units and short lemmas that base_solver learned
+   independently of the pool predicates.
+*/
 void solver_pool::refresh(solver* base_solver) {
     ast_manager& m = m_base_solver->get_manager();
     ref<solver> new_base = m_base_solver->translate(m, m_base_solver->get_params());
+    solver::phase* h = base_solver->get_phase();
+    if (h) {
+        h->filter([&](expr* e) { return is_shared(e); });
+        m_heuristics = h;
+        new_base->set_phase(h);
+        m_stats.m_num_inherited++;
+    }
     for (solver* s0 : m_solvers) {
         pool_solver* s = dynamic_cast<pool_solver*>(s0);
         if (base_solver == s->base_solver()) {
@@ -26,6 +26,7 @@ Notes:
 
 #include "solver/solver.h"
 #include "util/stopwatch.h"
+#include "util/obj_hashtable.h"
 
 class pool_solver;
 
@@ -37,6 +38,7 @@ class solver_pool {
         unsigned m_num_checks;
         unsigned m_num_sat_checks;
         unsigned m_num_undef_checks;
+        unsigned m_num_inherited;
         stats() { reset(); }
         void reset() { memset(this, 0, sizeof(*this)); }
     };
@@ -46,6 +48,8 @@ class solver_pool {
     unsigned            m_current_pool;
     sref_vector<solver> m_solvers;
     stats               m_stats;
+    obj_hashtable<func_decl> m_preds;       // predicates that guard the assertions of pool solvers
+    scoped_ptr<solver::phase> m_heuristics; // phases, activities and lemmas of the last retired base solver
 
     stopwatch m_check_watch;
     stopwatch m_check_sat_watch;
@@ -54,6 +58,8 @@ class solver_pool {
 
     void refresh(solver* s);
 
+    bool is_shared(expr* e) const;
+
     ptr_vector<solver> get_base_solvers() const;
   
 public:
@@ -0,0 +1,147 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    cost_evaluator.cpp
+
+Abstract:
+
+    The compiled form of a cost function, cost_program, gives the
+    same results as cost_evaluator.
+
+--*/
+
+#include "ast/cost_evaluator.h"
+#include "ast/reg_decl_plugins.h"
+#include "ast/ast_pp.h"
+#include "util/warning.h"
+#include "util/util.h"
+#include <cmath>
+
+class cost_expr_gen {
+    ast_manager & m;
+    arith_util    a;
+    random_gen &  r;
+    unsigned      m_num_vars;
+
+    expr * mk_num() {
+        switch (r(5)) {
+        case 0:  return a.mk_real(0);
+        case 1:  return a.mk_real(1);
+        case 2:  return a.mk_real(2);
+        case 3:  return a.mk_real(rational(1, 2));
+        default: return a.mk_real(-3);
+        }
+    }
+
+    expr * mk_leaf() {
+        if (r(3) == 0)
+            return mk_num();
+        return m.mk_var(r(m_num_vars), a.mk_real());
+    }
+
+public:
+    cost_expr_gen(ast_manager & m, random_gen & r, unsigned num_vars):
+        m(m), a(m), r(r), m_num_vars(num_vars) {}
+
+    expr_ref mk_arith(unsigned depth) {
+        if (depth == 0 || r(4) == 0)
+            return expr_ref(mk_leaf(), m);
+        expr_ref e1 = mk_arith(depth - 1), e2 = mk_arith(depth - 1);
+        switch (r(7)) {
+        case 0:  return expr_ref(a.mk_add(e1, e2), m);
+        case 1:  return expr_ref(a.mk_sub(e1, e2), m);
+        case 2:  return expr_ref(a.mk_mul(e1, e2), m);
+        case 3:  return expr_ref(a.mk_div(e1, r(3) == 0 ? a.mk_real(0) : e2.get()), m);
+        case 4:  return expr_ref(a.mk_uminus(e1), m);
+        default: return expr_ref(m.mk_ite(mk_bool(depth - 1), e1, e2), m);
+        }
+    }
+
+    expr_ref mk_bool(unsigned depth) {
+        if (depth == 0 || r(5) == 0)
+            return expr_ref(r(2) == 0 ? m.mk_true() : m.mk_false(), m);
+        switch (r(11)) {
+        case 0:  return expr_ref(m.mk_not(mk_bool(depth - 1)), m);
+        case 1:
+        case 2: {
+            expr_ref_vector args(m);
+            unsigned n = 1 + r(3);
+            for (unsigned i = 0; i < n; ++i)
+                args.push_back(mk_bool(depth - 1));
+            return expr_ref(r(2) == 0 ? m.mk_and(args) : m.mk_or(args), m);
+        }
+        case 3:  return expr_ref(m.mk_implies(mk_bool(depth - 1), mk_bool(depth - 1)), m);
+        case 4:  return expr_ref(m.mk_xor(mk_bool(depth - 1), mk_bool(depth - 1)), m);
+        case 5:  return expr_ref(m.mk_eq(mk_arith(depth - 1), mk_arith(depth - 1)), m);
+        case 6:  return expr_ref(a.mk_le(mk_arith(depth - 1), mk_arith(depth - 1)), m);
+        case 7:  return expr_ref(a.mk_ge(mk_arith(depth - 1), mk_arith(depth - 1)), m);
+        case 8:  return expr_ref(a.mk_lt(mk_arith(depth - 1), mk_arith(depth - 1)), m);
+        case 9:  return expr_ref(a.mk_gt(mk_arith(depth - 1), mk_arith(depth - 1)), m);
+        default: return expr_ref(m.mk_ite(mk_bool(depth - 1), mk_bool(depth - 1), mk_bool(depth - 1)), m);
+        }
+    }
+};
+
+static bool same_cost(float x, float y) {
+    return x == y || (std::isnan(x) && std::isnan(y));
+}
+
+static void check_cost(ast_manager & m, expr * e, unsigned num_args, random_gen & r) {
+    static float const values[] = { 0.0f, 1.0f, -1.0f, 2.0f, 0.5f, 3.0f };
+    cost_evaluator eval(m);
+    cost_program prog(m);
+    ENSURE(prog.compile(e, num_args));
+    svector<float> args;
+    for (unsigned k = 0; k < 20; ++k) {
+        args.reset();
+        for (unsigned i = 0; i < num_args; ++i)
+            args.push_back(values[r(6)]);
+        float expected = eval(e, num_args, args.data());
+        float actual = prog(args.data());
+        if (!same_cost(expected, actual)) {
+            std::cout << mk_pp(e, m) << "\nargs:";
+            for (float v : args)
+                std::cout << " " << v;
+            std::cout << "\nevaluator: " << expected << " program: " << actual << "\n";
+        }
+        ENSURE(same_cost(expected, actual));
+    }
+}
+
+void tst_cost_evaluator() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    random_gen r(0);
+    unsigned const num_vars = 3;
+    cost_expr_gen gen(m, r, num_vars);
+    enable_warning_messages(false);
+
+    // constants, variables and sums of two variables do not use the stack.
+    expr_ref e(a.mk_real(7), m);
+    check_cost(m, e, num_vars, r);
+    e = m.mk_var(1, a.mk_real());
+    check_cost(m, e, num_vars, r);
+    e = a.mk_add(m.mk_var(0, a.mk_real()), m.mk_var(2, a.mk_real()));
+    check_cost(m, e, num_vars, r);
+
+    for (unsigned i = 0; i < 500; ++i) {
+        e = gen.mk_arith(5);
+        check_cost(m, e, num_vars, r);
+        e = gen.mk_bool(5);
+        check_cost(m, e, num_vars, r);
+    }
+
+    // expressions that cost_evaluator reports as errors are not compiled.
+    cost_program prog(m);
+    expr_ref c(m.mk_const(symbol("c"), a.mk_real()), m);
+    e = a.mk_add(c, a.mk_real(1));
+    ENSURE(!prog.compile(e, num_vars));
+    e = m.mk_var(num_vars, a.mk_real());
+    ENSURE(!prog.compile(e, num_vars));
+    ENSURE(!prog.compiled());
+
+    enable_warning_messages(true);
+}
@@ -0,0 +1,60 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    gparams.cpp
+
+Abstract:
+
+    Resetting the global parameters keeps the parameter modules registered.
+    The batch mode of the shell resets the parameters before every script
+    and sets the parameters of the command line again.
+
+--*/
+
+#include "util/gparams.h"
+#include "cmd_context/cmd_context.h"
+#include "parsers/smt2/smt2parser.h"
+#include "solver/solver.h"
+#include <sstream>
+
+static std::string run_script(char const * script) {
+    gparams::reset();
+    gparams::set("model.compact", "false");
+    std::ostringstream out;
+    {
+        cmd_context ctx;
+        ctx.set_solver_factory(mk_smt_strategic_solver_factory());
+        ctx.set_regular_stream(out);
+        ctx.set_diagnostic_stream(out);
+        std::istringstream in(script);
+        parse_smt2_commands(ctx, in);
+    }
+    return out.str();
+}
+
+void tst_gparams() {
+    char const * script1 =
+        "(declare-const x Int)\n"
+        "(assert (> x 2))\n"
+        "(check-sat)\n"
+        "(get-value (x))\n";
+    char const * script2 =
+        "(declare-const y Int)\n"
+        "(assert (> y 3))\n"
+        "(check-sat)\n"
+        "(get-model)\n";
+    for (unsigned i = 0; i < 2; ++i) {
+        std::string out1 = run_script(script1);
+        std::string out2 = run_script(script2);
+        std::cout << out1 << out2;
+        ENSURE(out1.find("error") == std::string::npos);
+        ENSURE(out2.find("error") == std::string::npos);
+        ENSURE(out1.find("((x 3))") != std::string::npos);
+        ENSURE(out2.find("define-fun y") != std::string::npos);
+        ENSURE(gparams::get_value("model.compact") == "false");
+    }
+    gparams::reset();
+    ENSURE(gparams::get_value("model.compact") == "true");
+}
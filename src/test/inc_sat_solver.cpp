@@ -0,0 +1,101 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    inc_sat_solver.cpp
+
+Abstract:
+
+    The incremental SAT solver reuses assumption literals and unsat
+    cores across checks until the next pop.
+
+--*/
+
+#include "sat/sat_solver/inc_sat_solver.h"
+#include "ast/reg_decl_plugins.h"
+#include "util/statistics.h"
+#include <cstring>
+
+static unsigned get_uint_stat(solver& s, char const* key) {
+    statistics st;
+    s.collect_statistics(st);
+    for (unsigned i = 0; i < st.size(); ++i)
+        if (st.is_uint(i) && strcmp(st.get_key(i), key) == 0)
+            return st.get_uint_value(i);
+    return 0;
+}
+
+static lbool check(solver& s, expr_ref_vector const& asms, expr_ref_vector& core) {
+    lbool r = s.check_sat(asms);
+    core.reset();
+    if (r == l_false) {
+        s.get_unsat_core(core);
+        for (expr* e : core)
+            ENSURE(asms.contains(e));
+    }
+    return r;
+}
+
+void tst_inc_sat_solver() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    params_ref p;
+    ref<solver> s = mk_inc_sat_solver(m, p);
+    expr_ref a(m.mk_const(symbol("a"), m.mk_bool_sort()), m);
+    expr_ref b(m.mk_const(symbol("b"), m.mk_bool_sort()), m);
+    expr_ref c(m.mk_const(symbol("c"), m.mk_bool_sort()), m);
+    expr_ref d(m.mk_const(symbol("d"), m.mk_bool_sort()), m);
+    expr_ref c_or_d(m.mk_or(c, d), m);
+    s->assert_expr(m.mk_or(m.mk_not(a), m.mk_not(b)));
+
+    expr_ref_vector asms(m), core(m);
+    asms.push_back(a);
+    asms.push_back(b);
+    asms.push_back(c_or_d);
+    ENSURE(check(*s, asms, core) == l_false);
+    ENSURE(core.contains(a) && core.contains(b) && !core.contains(c_or_d));
+    ENSURE(get_uint_stat(*s, "sat assumptions reused") == 0);
+    ENSURE(get_uint_stat(*s, "sat cores reused") == 0);
+
+    // the literals of a and b are reused, and the core over them answers the check.
+    asms.reset();
+    asms.push_back(d);
+    asms.push_back(b);
+    asms.push_back(a);
+    ENSURE(check(*s, asms, core) == l_false);
+    ENSURE(core.size() == 2 && core.contains(a) && core.contains(b));
+    ENSURE(get_uint_stat(*s, "sat assumptions reused") == 2);
+    ENSURE(get_uint_stat(*s, "sat cores reused") == 1);
+
+    // the proxy of the non-literal assumption is reused and the search runs.
+    asms.reset();
+    asms.push_back(a);
+    asms.push_back(c_or_d);
+    ENSURE(check(*s, asms, core) == l_true);
+    ENSURE(get_uint_stat(*s, "sat cores reused") == 1);
+    unsigned num_reused = get_uint_stat(*s, "sat assumptions reused");
+    ENSURE(num_reused >= 4);
+
+    // added formulas do not invalidate the cached cores.
+    s->assert_expr(m.mk_not(c));
+    s->assert_expr(m.mk_not(d));
+    ENSURE(check(*s, asms, core) == l_false);
+    ENSURE(core.size() == 1 && core.contains(c_or_d));
+    asms.push_back(b);
+    ENSURE(check(*s, asms, core) == l_false);
+    ENSURE(get_uint_stat(*s, "sat cores reused") == 2);
+
+    // pop discards the cached literals and cores.
+    s->push();
+    s->assert_expr(a);
+    asms.reset();
+    asms.push_back(b);
+    ENSURE(check(*s, asms, core) == l_false);
+    ENSURE(core.size() == 1 && core.contains(b));
+    s->pop(1);
+    num_reused = get_uint_stat(*s, "sat assumptions reused");
+    ENSURE(check(*s, asms, core) == l_true);
+    ENSURE(get_uint_stat(*s, "sat assumptions reused") == num_reused);
+    ENSURE(get_uint_stat(*s, "sat cores reused") == 2);
+}
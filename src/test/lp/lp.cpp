@@ -61,6 +61,7 @@
 #include "math/lp/emonics.h"
 namespace nla {
 void test_horner();
+void test_grobner_reuse();
 void test_monics();
 void test_order_lemma();
 void test_monotone_lemma();
@@ -2158,6 +2159,7 @@ void setup_args_parser(argument_parser & parser) {
     parser.add_option_with_help_string("-nla_monot", "test nla_solver order lemma");
     parser.add_option_with_help_string("-nla_tan", "test_tangent_lemma");
     parser.add_option_with_help_string("-nla_bsl", "test_basic_sign_lemma");
+    parser.add_option_with_help_string("-nla_grobner_reuse", "test reusing the Grobner basis after horner");
     parser.add_option_with_help_string("-horner", "test horner's heuristic");
     parser.add_option_with_help_string("-nla_blnt_mf", "test_basic_lemma_for_mon_neutral_from_monomial_to_factors");
     parser.add_option_with_help_string("-nla_blnt_fm", "test_basic_lemma_for_mon_neutral_from_factors_to_monomial");
@@ -2202,6 +2204,8 @@ void setup_args_parser(argument_parser & parser) {
     parser.add_option_with_help_string("--randomize_lar", "test randomize functionality");
     parser.add_option_with_help_string("--smap", "test stacked_map");
     parser.add_option_with_help_string("--term", "simple term test");
+    parser.add_option_with_help_string("--signature", "test moving a non-basic column to a bound of a solution signature");
+    parser.add_option_with_help_string("--float_simplex", "test the floating point simplex with rational repair");
     parser.add_option_with_help_string("--eti"," run a small evidence test for total infeasibility scenario");
     parser.add_option_with_help_string("--row_inf", "forces row infeasibility search");
     parser.add_option_with_help_string("-pd", "presolve with double solver");
@@ -2982,6 +2986,90 @@ void test_term() {
     
 }
 
+// a boxed column above its upper bound is moved to the upper bound, not past it
+void test_update_xj_to_upper_bound() {
+    lp_settings settings;
+    lar_solver namer;
+    lar_core_solver lcs(settings, namer);
+    lcs.m_column_types.push_back(column_type::boxed);
+    lcs.m_r_lower_bounds.push_back(impq(mpq(0)));
+    lcs.m_r_upper_bounds.push_back(impq(mpq(2)));
+    lcs.m_r_x.push_back(impq(mpq(5)));
+    lcs.m_r_heading.push_back(-1);
+    lcs.m_r_nbasis.push_back(0);
+    lcs.m_r_solver.resize_inf_set(1);
+    lcs.m_r_solver.insert_column_into_inf_set(0);
+    impq delta;
+    VERIFY(lcs.update_xj_and_get_delta(0, not_at_bound, delta));
+    VERIFY(lcs.m_r_x[0] == impq(mpq(2)));
+    VERIFY(delta == impq(mpq(-3)));
+    VERIFY(!lcs.m_r_solver.inf_set_contains(0));
+}
+
+static void set_float_simplex(lar_solver & solver) {
+    solver.settings().float_simplex() = true;
+    solver.settings().float_simplex_min_inf() = 1;
+}
+
+// the basis found by the floating point simplex is feasible in rationals
+void test_float_simplex_hit() {
+    lar_solver solver;
+    set_float_simplex(solver);
+    unsigned n = 10;
+    vector<var_index> xs;
+    for (unsigned i = 0; i < n; i++) {
+        xs.push_back(solver.add_var(i, false));
+        solver.add_var_bound(xs.back(), GE, mpq(0));
+        solver.add_var_bound(xs.back(), LE, mpq(10));
+    }
+    // x_i + x_{i+1} >= i + 1
+    for (unsigned i = 0; i + 1 < n; i++) {
+        vector<std::pair<mpq, var_index>> ls;
+        ls.push_back(std::make_pair(mpq(1), xs[i]));
+        ls.push_back(std::make_pair(mpq(1), xs[i + 1]));
+        unsigned t = solver.add_term(ls, n + i);
+        solver.add_var_bound(t, GE, mpq(i + 1));
+    }
+    auto & st = solver.settings().stats();
+    VERIFY(solver.find_feasible_solution() == lp_status::OPTIMAL);
+    std::unordered_map<var_index, mpq> model;
+    solver.get_model(model);
+    for (unsigned i = 0; i < n; i++)
+        VERIFY(mpq(0) <= model[xs[i]] && model[xs[i]] <= mpq(10));
+    for (unsigned i = 0; i + 1 < n; i++)
+        VERIFY(model[xs[i]] + model[xs[i + 1]] >= mpq(i + 1));
+    VERIFY(st.m_float_simplex_calls > 0);
+    VERIFY(st.m_float_simplex_hits > 0);
+}
+
+// the floating point simplex cannot distinguish 1 + 10^-30 from 1: every vertex it
+// can stop at violates a bound in rationals, and its basis is repaired by the rational simplex
+void test_float_simplex_repair() {
+    lar_solver solver;
+    set_float_simplex(solver);
+    var_index x = solver.add_var(0, false);
+    var_index y = solver.add_var(1, false);
+    solver.add_var_bound(x, GE, mpq(0));
+    solver.add_var_bound(x, LE, mpq(1));
+    solver.add_var_bound(y, GE, mpq(0));
+    solver.add_var_bound(y, LE, mpq(1));
+    mpq eps = mpq(1) / power(mpq(10), 30);
+    vector<std::pair<mpq, var_index>> ls;
+    ls.push_back(std::make_pair(mpq(1), x));
+    ls.push_back(std::make_pair(mpq(1), y));
+    unsigned t = solver.add_term(ls, 2);
+    solver.add_var_bound(t, GE, mpq(1) + eps);
+    auto & st = solver.settings().stats();
+    VERIFY(solver.find_feasible_solution() == lp_status::OPTIMAL);
+    std::unordered_map<var_index, mpq> model;
+    solver.get_model(model);
+    VERIFY(mpq(0) <= model[x] && model[x] <= mpq(1));
+    VERIFY(mpq(0) <= model[y] && model[y] <= mpq(1));
+    VERIFY(model[x] + model[y] >= mpq(1) + eps);
+    VERIFY(st.m_float_simplex_calls > 0);
+    VERIFY(st.m_float_simplex_hits == 0);
+}
+
 void test_evidence_for_total_inf_simple(argument_parser & args_parser) {
     lar_solver solver;
     var_index x = solver.add_var(0, false);
@@ -3901,6 +3989,13 @@ void test_lp_local(int argn, char**argv) {
         return finalize(0);
     }
 
+    if (args_parser.option_is_used("-nla_grobner_reuse")) { 
+#ifdef Z3DEBUG
+        nla::test_grobner_reuse();
+#endif
+        return finalize(0);
+    }
+
     if (args_parser.option_is_used("-nla_tan")) { 
 #ifdef Z3DEBUG
         nla::test_tangent_lemma();
@@ -4074,6 +4169,17 @@ void test_lp_local(int argn, char**argv) {
         ret = 0;
         return finalize(ret);
     }
+    if (args_parser.option_is_used("--signature")) {
+        test_update_xj_to_upper_bound();
+        ret = 0;
+        return finalize(ret);
+    }
+    if (args_parser.option_is_used("--float_simplex")) {
+        test_float_simplex_hit();
+        test_float_simplex_repair();
+        ret = 0;
+        return finalize(ret);
+    }
     unsigned max_iters;
     unsigned time_limit;
     get_time_limit_and_max_iters_from_parser(args_parser, time_limit, max_iters);
@@ -915,4 +915,70 @@ void test_order_lemma() {
 }
 
 
+// The basis kept for the next Grobner run does not refer to the dependencies
+// of the interval manager, which horner resets between the runs.
+void test_grobner_reuse() {
+    std::cout << "test_grobner_reuse\n";
+    lp::lar_solver s;
+    lpvar lp_x = s.add_named_var(0, true, "x");
+    lpvar lp_y = s.add_named_var(1, true, "y");
+    lpvar lp_xy = s.add_named_var(2, true, "xy");
+    lp::lar_term t;
+    t.add_var(lp_xy);
+    t.add_var(lp_x);
+    lpvar lp_t = s.map_term_index_to_column_index(s.add_term(t.coeffs_as_vector(), -1));
+    unsigned lc = s.add_var_bound(lp_y, llc::GE, rational(2));
+    unsigned uc = s.add_var_bound(lp_y, llc::LE, rational(2));
+
+    reslimit l;
+    solver nla(s, l);
+    svector<lpvar> v; v.push_back(lp_x); v.push_back(lp_y);
+    nla.add_monic(lp_xy, v.size(), v.begin());
+    nla_settings& st = nla.settings();
+    st.grobner_reuse() = true;
+    st.grobner_subs_fixed() = 1;
+    st.horner_subs_fixed() = 0; // horner keeps the row nonlinear and resets the dependencies
+    st.grobner_eqs_growth() = 10;
+    st.grobner_expr_size_growth() = 2;
+    st.grobner_expr_degree_growth() = 2;
+    st.grobner_tree_size_growth() = 2;
+    st.grobner_max_simplified() = 10000;
+    st.grobner_number_of_conflicts_to_report() = 1;
+    st.grobner_quota() = 10;
+
+    // xy = 5 while x*y = 2
+    s_set_column_value_test(s, lp_x, rational(1));
+    s_set_column_value_test(s, lp_y, rational(2));
+    s_set_column_value_test(s, lp_xy, rational(5));
+    s_set_column_value_test(s, lp_t, rational(6));
+
+    core& c = nla.get_core();
+    vector<lemma> lv;
+    c.m_lemma_vec = &lv;
+    c.init_to_refine();
+    VERIFY(!c.m_to_refine.empty());
+    c.init_search();
+    c.run_grobner();
+    VERIFY(!c.m_pdd_grobner.equations().empty());
+
+    c.m_horner.horner_lemmas();
+    // dependencies allocated now take the place of the ones freed by horner
+    for (unsigned i = 0; i < 100; ++i)
+        c.m_intervals.mk_join(c.m_intervals.mk_leaf(1000), c.m_intervals.mk_leaf(1001));
+
+    unsigned reused = c.lp_settings().stats().m_grobner_reused_eqs;
+    c.run_grobner();
+    VERIFY(c.lp_settings().stats().m_grobner_reused_eqs > reused);
+    bool has_deps = false;
+    for (auto* e : c.m_pdd_grobner.equations()) {
+        unsigned_vector cis;
+        c.m_pdd_grobner.dep().linearize(e->dep(), cis);
+        for (unsigned ci : cis) {
+            VERIFY(ci == lc || ci == uc);
+            has_deps = true;
+        }
+    }
+    VERIFY(has_deps);
+}
+
 } // end of namespace nla
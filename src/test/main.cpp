@@ -247,11 +247,17 @@ int main(int argc, char ** argv) {
     TST(sorting_network);
     TST(theory_pb);
     TST(simplex);
+    TST(sat_parallel);
+    TST(sat_cube_and_conquer);
+    TST(sat_clause_use_list);
     TST(sat_user_scope);
     TST_ARGV(ddnf);
     TST(ddnf1);
     TST(model_evaluator);
+    TST(cost_evaluator);
+    TST(gparams);
     TST(get_consequences);
+    TST(inc_sat_solver);
     TST(pb2bv);
     TST_ARGV(sat_lookahead);
     TST_ARGV(sat_local_search);
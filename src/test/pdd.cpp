@@ -322,6 +322,38 @@ public :
         SASSERT(!(2*a*b + 3*b + 2).is_non_zero());
     }
 
+    /**
+     * Results of cached operations remain correct across garbage collections,
+     * and entries over surviving nodes are reused after a collection.
+     */
+    static void gc() {
+        std::cout << "\ngc\n";
+        pdd_manager m(4);
+        pdd a = m.mk_var(0);
+        pdd b = m.mk_var(1);
+        pdd c = m.mk_var(2);
+        pdd d = m.mk_var(3);
+        for (unsigned i = 0; i < 200; ++i) {
+            pdd p1 = a + i*b;
+            pdd p2 = c - i*d;
+            pdd p = p1 * p2;
+            pdd q = a*c - i*a*d + i*b*c - i*i*b*d;
+            VERIFY(p == q);
+            {
+                pdd r = (a + b + c + d + i) * (a - b + c - d);
+                r = r * r;
+                VERIFY(r - r == m.zero());
+            }
+            m.gc();
+            VERIFY(!m.m_free_nodes.empty());
+            VERIFY(!m.m_op_cache.empty());
+            unsigned num_entries = m.m_op_cache.size();
+            VERIFY(p1 * p2 == q);
+            VERIFY(m.m_op_cache.size() == num_entries);
+            VERIFY(((a + i*b) * (c - i*d)) == q);
+        }
+    }
+
 };
 
 }
@@ -336,4 +368,5 @@ void tst_pdd() {
     dd::test::order();
     dd::test::order_lm();
     dd::test::mod4_operations();
+    dd::test::gc();
 }
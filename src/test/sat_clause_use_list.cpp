@@ -0,0 +1,95 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    sat_clause_use_list.cpp
+
+Abstract:
+
+    The clause arena reuses the entries released by clause use lists.
+
+--*/
+
+#include "sat/sat_clause.h"
+#include "sat/sat_clause_use_list.h"
+#include "util/util.h"
+#include <algorithm>
+
+static void tst_clause_arena() {
+    sat::clause_arena a;
+    sat::clause** p4 = a.allocate(4);
+    sat::clause** p8 = a.allocate(8);
+    ENSURE(p4 != p8);
+
+    // released arrays are reused for requests of the same size class, last released first.
+    a.deallocate(p4, 4);
+    a.deallocate(p8, 8);
+    ENSURE(a.allocate(8) == p8);
+    ENSURE(a.allocate(3) == p4);
+    ENSURE(a.allocate(4) != p4);
+
+    // an array of 5 entries is only reused for requests of at most 4 entries.
+    sat::clause** p5 = a.allocate(5);
+    a.deallocate(p5, 5);
+    sat::clause** q = a.allocate(5);
+    ENSURE(q != p5);
+    ENSURE(a.allocate(4) == p5);
+
+    // after a reset the arena starts over with fresh blocks and empty free lists.
+    a.deallocate(q, 5);
+    a.reset();
+    sat::clause** r = a.allocate(4);
+    a.deallocate(r, 4);
+    ENSURE(a.allocate(4) == r);
+}
+
+static void tst_use_list_reuse() {
+    sat::clause_allocator ca;
+    sat::clause_arena a;
+    ptr_vector<sat::clause> clauses;
+    for (unsigned i = 0; i < 10; ++i) {
+        sat::literal lits[2] = { sat::literal(i, false), sat::literal(i + 1, true) };
+        clauses.push_back(ca.mk_clause(2, lits, i % 2 == 0));
+    }
+
+    // the entries of a list are returned to the arena when it grows or is reset,
+    // and the next list reuses them.
+    sat::clause_use_list l1, l2;
+    for (sat::clause* c : clauses)
+        l1.insert(*c, a);
+    ENSURE(l1.size() == 10 && l1.num_redundant() == 5);
+    sat::clause* const* entries = l1.begin();
+    l1.reset(a);
+    ENSURE(l1.empty());
+    sat::clause* const* first = nullptr;
+    for (sat::clause* c : clauses) {
+        l2.insert(*c, a);
+        if (!first)
+            first = l2.begin();
+    }
+    ENSURE(l2.size() == 10);
+    ENSURE(l2.begin() == entries);
+    ENSURE(std::equal(l2.begin(), l2.end(), clauses.begin()));
+
+    // lists sized in bulk use the entries released by growing lists.
+    sat::clause_use_list l3;
+    for (unsigned i = 0; i < 4; ++i)
+        l3.reserve_one();
+    l3.allocate(a);
+    ENSURE(l3.begin() == first);
+    for (unsigned i = 0; i < 4; ++i)
+        l3.insert(*clauses[i], a);
+    ENSURE(l3.size() == 4 && l3.begin() == first);
+    ENSURE(l3.check_invariant());
+    l2.reset(a);
+    l3.reset(a);
+
+    for (sat::clause* c : clauses)
+        ca.del_clause(c);
+}
+
+void tst_sat_clause_use_list() {
+    tst_clause_arena();
+    tst_use_list_reuse();
+}
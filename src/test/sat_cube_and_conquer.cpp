@@ -0,0 +1,96 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    sat_cube_and_conquer.cpp
+
+Abstract:
+
+    Cube and conquer gives the same results as sequential search,
+    also under assumptions, and shares the units and the negated
+    cores of refuted cubes between its workers.
+
+--*/
+
+#include "sat/sat_solver.h"
+#include "util/statistics.h"
+#include "util/util.h"
+#include <cstring>
+
+typedef vector<sat::literal_vector> clauses_t;
+
+static void mk_random_3sat(random_gen& r, unsigned num_vars, unsigned num_clauses, clauses_t& clauses) {
+    clauses.reset();
+    for (unsigned i = 0; i < num_clauses; ++i) {
+        sat::literal_vector cls;
+        for (unsigned j = 0; j < 3; ++j)
+            cls.push_back(sat::literal(r(num_vars), r(2) == 0));
+        clauses.push_back(cls);
+    }
+}
+
+static unsigned get_uint_stat(statistics const& st, char const* key) {
+    for (unsigned i = 0; i < st.size(); ++i)
+        if (st.is_uint(i) && strcmp(st.get_key(i), key) == 0)
+            return st.get_uint_value(i);
+    return 0;
+}
+
+static lbool check(params_ref const& p, unsigned num_vars, clauses_t const& clauses, sat::literal_vector const& asms, statistics& st) {
+    reslimit rlim;
+    sat::solver s(p, rlim);
+    for (unsigned i = 0; i < num_vars; ++i)
+        s.mk_var();
+    for (sat::literal_vector const& cls : clauses)
+        s.mk_clause(cls.size(), cls.data());
+    lbool r = s.check(asms.size(), asms.data());
+    if (r == l_true) {
+        sat::model const& m = s.get_model();
+        for (sat::literal_vector const& cls : clauses) {
+            bool is_sat = false;
+            for (sat::literal l : cls)
+                is_sat |= m[l.var()] == (l.sign() ? l_false : l_true);
+            ENSURE(is_sat);
+        }
+        for (sat::literal l : asms)
+            ENSURE(m[l.var()] == (l.sign() ? l_false : l_true));
+    }
+    if (r == l_false)
+        for (sat::literal l : s.get_core())
+            ENSURE(asms.contains(l));
+    s.collect_statistics(st);
+    return r;
+}
+
+void tst_sat_cube_and_conquer() {
+    random_gen r(0);
+    unsigned num_vars = 120;
+    params_ref p1;
+    params_ref p2;
+    p2.set_bool("cube_and_conquer", true);
+    p2.set_uint("threads", 3);
+    // a small budget makes workers split cubes again and share their results.
+    p2.set_uint("cube_and_conquer.conflicts", 20);
+    clauses_t clauses;
+    unsigned num_unsat = 0, num_refuted = 0, num_lemmas = 0, num_splits = 0;
+    for (unsigned k = 0; k < 10; ++k) {
+        mk_random_3sat(r, num_vars, 520, clauses);
+        sat::literal_vector asms;
+        if (k % 2 == 1)
+            for (unsigned i = 0; i < 3; ++i)
+                asms.push_back(sat::literal(r(num_vars), r(2) == 0));
+        statistics st1, st2;
+        lbool r1 = check(p1, num_vars, clauses, asms, st1);
+        lbool r2 = check(p2, num_vars, clauses, asms, st2);
+        ENSURE(r1 == r2);
+        num_unsat += r2 == l_false;
+        num_refuted += get_uint_stat(st2, "sat cc refuted");
+        num_lemmas += get_uint_stat(st2, "sat cc lemmas");
+        num_splits += get_uint_stat(st2, "sat cc splits");
+    }
+    ENSURE(num_unsat > 0);
+    ENSURE(num_refuted > 0);
+    ENSURE(num_lemmas > 0);
+    ENSURE(num_splits > 0);
+}
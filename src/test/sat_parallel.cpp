@@ -0,0 +1,111 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    sat_parallel.cpp
+
+Abstract:
+
+    Solving with several threads that exchange clauses during search
+    gives the same results as solving with one thread.
+
+--*/
+
+#include "sat/sat_solver.h"
+#include "sat/sat_parallel.h"
+#include "util/util.h"
+
+typedef vector<sat::literal_vector> clauses_t;
+
+static void mk_random_3sat(random_gen& r, unsigned num_vars, unsigned num_clauses, clauses_t& clauses) {
+    clauses.reset();
+    for (unsigned i = 0; i < num_clauses; ++i) {
+        sat::literal_vector cls;
+        for (unsigned j = 0; j < 3; ++j)
+            cls.push_back(sat::literal(r(num_vars), r(2) == 0));
+        clauses.push_back(cls);
+    }
+}
+
+static lbool check(params_ref const& p, unsigned num_vars, clauses_t const& clauses) {
+    reslimit rlim;
+    sat::solver s(p, rlim);
+    for (unsigned i = 0; i < num_vars; ++i)
+        s.mk_var();
+    for (sat::literal_vector const& cls : clauses)
+        s.mk_clause(cls.size(), cls.data());
+    lbool r = s.check();
+    if (r == l_true) {
+        sat::model const& m = s.get_model();
+        for (sat::literal_vector const& cls : clauses) {
+            bool is_sat = false;
+            for (sat::literal l : cls)
+                is_sat |= m[l.var()] == (l.sign() ? l_false : l_true);
+            ENSURE(is_sat);
+        }
+    }
+    return r;
+}
+
+// local search threads keep the assignment with fewest unsatisfied clauses,
+// average clause weights and seed the phases of the CDCL solver.
+static void tst_exchange_local_search() {
+    reslimit rlim;
+    params_ref p;
+    sat::solver s(p, rlim);
+    for (unsigned i = 0; i < 4; ++i)
+        s.mk_var();
+    sat::parallel par(s);
+    bool_vector best, values;
+    best.push_back(true); best.push_back(false); best.push_back(true); best.push_back(true);
+    unsigned_vector w1, w2;
+    w1.push_back(1); w1.push_back(4); w1.push_back(6);
+    w2.push_back(3); w2.push_back(4); w2.push_back(1);
+
+    unsigned num_unsat = 2;
+    values.append(best);
+    ENSURE(!par.exchange_local_search(num_unsat, values, w1));
+    ENSURE(w1[0] == 1 && w1[1] == 4 && w1[2] == 6);
+
+    // a thread with more unsatisfied clauses continues from the best assignment.
+    num_unsat = 5;
+    values.reset();
+    values.resize(4, false);
+    ENSURE(par.exchange_local_search(num_unsat, values, w2));
+    ENSURE(num_unsat == 2);
+    ENSURE(values == best);
+    ENSURE(w2[0] == 2 && w2[1] == 4 && w2[2] == 4);
+
+    // weights of threads with different clauses are not averaged.
+    unsigned_vector w3;
+    w3.push_back(7); w3.push_back(7);
+    num_unsat = 2;
+    ENSURE(!par.exchange_local_search(num_unsat, values, w3));
+    ENSURE(w3[0] == 7 && w3[1] == 7);
+
+    // the best assignment is copied into the phases once.
+    ENSURE(!par.to_solver(s));
+    for (unsigned v = 0; v < 4; ++v)
+        ENSURE(s.get_phase(v) == best[v]);
+    s.set_phase(sat::literal(0, true));
+    par.to_solver(s);
+    ENSURE(!s.get_phase(0));
+}
+
+void tst_sat_parallel() {
+    tst_exchange_local_search();
+    random_gen r(0);
+    unsigned num_vars = 150;
+    params_ref p1;
+    params_ref p2;
+    p2.set_uint("threads", 3);
+    p2.set_uint("par.import_interval", 1);
+    clauses_t clauses;
+    for (unsigned k = 0; k < 10; ++k) {
+        mk_random_3sat(r, num_vars, 640, clauses);
+        lbool r1 = check(p1, num_vars, clauses);
+        lbool r2 = check(p2, num_vars, clauses);
+        ENSURE(r1 == r2);
+    }
+}
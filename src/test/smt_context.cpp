@@ -5,10 +5,254 @@ Copyright (c) 2015 Microsoft Corporation
 --*/
 
 #include "smt/smt_context.h"
+#include "smt/smt_kernel.h"
 #include "ast/reg_decl_plugins.h"
+#include "ast/arith_decl_plugin.h"
+#include "ast/pb_decl_plugin.h"
+#include "util/statistics.h"
+#include <cstring>
+#include <sstream>
+#include <algorithm>
+#include <thread>
+#include <chrono>
+
+static void tst_snapshot() {
+    smt_params params;
+    ast_manager m;
+    reg_decl_plugins(m);
+    smt::kernel k(m, params);
+
+    app_ref a(m.mk_const(symbol("a"), m.mk_bool_sort()), m);
+    app_ref b(m.mk_const(symbol("b"), m.mk_bool_sort()), m);
+    app_ref c(m.mk_const(symbol("c"), m.mk_bool_sort()), m);
+    k.assert_expr(m.mk_or(a, b));
+    k.push();
+    k.assert_expr(m.mk_or(m.mk_not(a), c));
+    ENSURE(k.check() == l_true);
+    smt::snapshot_ref s = alloc(smt::snapshot, m);
+    k.get_snapshot(*s);
+    ENSURE(s->num_scopes() == 1);
+    k.push();
+    k.assert_expr(m.mk_not(b));
+    k.assert_expr(m.mk_not(c));
+    ENSURE(k.check() == l_false);
+    k.pop(2);
+    k.assert_expr(m.mk_not(c));
+
+    k.restore(*s);
+    ENSURE(k.get_scope_level() == 1);
+    k.assert_expr(m.mk_not(b));
+    ENSURE(k.check() == l_true);
+    k.assert_expr(m.mk_not(c));
+    ENSURE(k.check() == l_false);
+    k.pop(1);
+    ENSURE(k.check() == l_true);
+    k.assert_expr(m.mk_not(a));
+    k.assert_expr(m.mk_not(b));
+    ENSURE(k.check() == l_false);
+}
+
+static unsigned get_uint_stat(statistics const& st, char const* key) {
+    for (unsigned i = 0; i < st.size(); ++i)
+        if (st.is_uint(i) && strcmp(st.get_key(i), key) == 0)
+            return st.get_uint_value(i);
+    return 0;
+}
+
+// pigeon hole problem: n + 1 pigeons in n holes, satisfiable if extra_hole is set.
+static lbool check_pigeon_hole(smt_params& params, unsigned n, bool extra_hole, statistics& st) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    smt::context ctx(m, params);
+    unsigned holes = extra_hole ? n + 1 : n;
+    vector<expr_ref_vector> p;
+    for (unsigned i = 0; i <= n; ++i) {
+        p.push_back(expr_ref_vector(m));
+        for (unsigned j = 0; j < holes; ++j)
+            p.back().push_back(m.mk_const(symbol((std::string("p") + std::to_string(i) + "_" + std::to_string(j)).c_str()), m.mk_bool_sort()));
+        ctx.assert_expr(m.mk_or(p.back()));
+    }
+    for (unsigned j = 0; j < holes; ++j)
+        for (unsigned i = 0; i <= n; ++i)
+            for (unsigned k = i + 1; k <= n; ++k)
+                ctx.assert_expr(m.mk_not(m.mk_and(p[i].get(j), p[k].get(j))));
+    lbool r = ctx.check();
+    st.reset();
+    ctx.collect_statistics(st);
+    return r;
+}
+
+// run the tiered lemma garbage collection often enough to delete and demote lemmas.
+static void tst_tiered_lemma_gc() {
+    smt_params params;
+    params.m_lemma_gc_tiered = true;
+    params.m_lemma_gc_strategy = LGC_FIXED;
+    params.m_lemma_gc_initial = 20;
+    params.m_recent_lemmas_size = 5;
+    statistics st;
+    ENSURE(check_pigeon_hole(params, 6, false, st) == l_false);
+    ENSURE(get_uint_stat(st, "conflicts") > params.m_lemma_gc_initial);
+    ENSURE(get_uint_stat(st, "del inactive lemmas") > 0);
+    ENSURE(check_pigeon_hole(params, 6, true, st) == l_true);
+
+    // every lemma is in the core tier and is never deleted by tiered garbage collection.
+    params.m_lemma_gc_tier1_glue = UINT_MAX;
+    ENSURE(check_pigeon_hole(params, 6, false, st) == l_false);
+    ENSURE(get_uint_stat(st, "conflicts") > params.m_lemma_gc_initial);
+    ENSURE(get_uint_stat(st, "del inactive lemmas") == 0);
+}
+
+// parallel contexts exchange short lemmas of low glue between rounds, unless share_glue is 0.
+static void tst_parallel_lemma_sharing() {
+    smt_params params;
+    params.m_threads = 2;
+    params.m_threads_max_conflicts = 50;
+    bool is_parallel = std::thread::hardware_concurrency() >= params.m_threads;
+    statistics st;
+    for (unsigned k = 0; k < 2; ++k) {
+        bool extra_hole = k == 1;
+        ENSURE(check_pigeon_hole(params, 6, extra_hole, st) == (extra_hole ? l_true : l_false));
+        unsigned num_shared = get_uint_stat(st, "smt parallel shared lemmas");
+        ENSURE(!is_parallel || extra_hole || num_shared > 0);
+        ENSURE(is_parallel || num_shared == 0);
+    }
+    params.m_threads_share_glue = 0;
+    ENSURE(check_pigeon_hole(params, 6, false, st) == l_false);
+    ENSURE(get_uint_stat(st, "smt parallel shared lemmas") == 0);
+}
+
+// quantifiers f_k(g(x)) = x and ground disequalities between f_k(g(c_i)) and c_{i+1}.
+static void mk_ematching_problem(ast_manager& m, expr_ref_vector& qs, expr_ref_vector& ground) {
+    sort_ref u(m.mk_uninterpreted_sort(symbol("U")), m);
+    sort* us[1] = { u.get() };
+    func_decl_ref g(m.mk_func_decl(symbol("g"), u, u), m);
+    expr_ref x(m.mk_var(0, u), m);
+    symbol x_name("x");
+    unsigned const num_funs = 4, num_consts = 100;
+    func_decl_ref_vector fs(m);
+    for (unsigned k = 0; k < num_funs; ++k) {
+        fs.push_back(m.mk_func_decl(symbol(("f" + std::to_string(k)).c_str()), u, u));
+        app_ref t(m.mk_app(fs.get(k), m.mk_app(g.get(), x.get())), m);
+        app_ref pat(m.mk_pattern(t), m);
+        expr* pats[1] = { pat.get() };
+        qs.push_back(m.mk_forall(1, us, &x_name, m.mk_eq(t, x), 0, symbol::null, symbol::null, 1, pats));
+    }
+    expr_ref_vector cs(m);
+    for (unsigned i = 0; i < num_consts; ++i)
+        cs.push_back(m.mk_const(symbol(("c" + std::to_string(i)).c_str()), u));
+    for (unsigned k = 0; k < num_funs; ++k)
+        for (unsigned i = 0; i < num_consts; ++i)
+            ground.push_back(m.mk_not(m.mk_eq(m.mk_app(fs.get(k), m.mk_app(g.get(), cs.get(i))), cs.get((i + 1) % num_consts))));
+}
+
+// instances found by E-matching with the given number of threads, one line per instance.
+static void get_ematching_instances(ast_manager& m, expr_ref_vector const& qs, expr_ref_vector const& ground, 
+                                    unsigned num_threads, vector<std::string>& instances) {
+    smt_params params;
+    params.m_ematching_threads = num_threads;
+    params.m_mbqi = false;
+    smt::context ctx(m, params);
+    for (expr* q : qs)
+        ctx.assert_expr(q);
+    // the patterns are registered before the ground terms are added,
+    // so the terms are matched as candidates of the code trees.
+    ENSURE(ctx.check() != l_false);
+    for (expr* e : ground)
+        ctx.assert_expr(e);
+    ENSURE(ctx.check() != l_false);
+    std::ostringstream out;
+    ctx.get_fingerprints().display(out);
+    std::istringstream in(out.str());
+    std::string line;
+    while (std::getline(in, line))
+        instances.push_back(line);
+    std::sort(instances.begin(), instances.end());
+}
+
+// parallel E-matching finds the same instances as sequential E-matching.
+static void tst_parallel_ematching() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    expr_ref_vector qs(m), ground(m);
+    mk_ematching_problem(m, qs, ground);
+    vector<std::string> seq, par;
+    get_ematching_instances(m, qs, ground, 1, seq);
+    get_ematching_instances(m, qs, ground, 4, par);
+    ENSURE(seq.size() > 400);
+    ENSURE(seq == par);
+}
+
+static bool has_stat(statistics const& st, char const* key) {
+    for (unsigned i = 0; i < st.size(); ++i)
+        if (strcmp(st.get_key(i), key) == 0)
+            return true;
+    return false;
+}
+
+static void tst_profiler() {
+    // nested scopes are charged their self time and reported per theory and as folded stacks.
+    smt::literal_vector assigned;
+    smt::profiler p(assigned);
+    auto wait = []() { std::this_thread::sleep_for(std::chrono::milliseconds(2)); };
+    for (unsigned i = 0; i < 2; ++i) {
+        smt::profiler::scope _outer(&p, "arithmetic", smt::profiler::PROPAGATE);
+        wait();
+        assigned.push_back(smt::literal(i));
+        smt::profiler::scope _inner(&p, "bit-vector", smt::profiler::INTERNALIZE);
+        wait();
+    }
+    statistics st;
+    p.collect_statistics(st);
+    ENSURE(has_stat(st, "time.smt.arithmetic.propagate"));
+    ENSURE(has_stat(st, "time.smt.bit-vector.internalize"));
+    ENSURE(get_uint_stat(st, "smt.arithmetic.propagate.calls") == 2);
+    ENSURE(get_uint_stat(st, "smt.arithmetic.propagate.propagations") == 2);
+    ENSURE(get_uint_stat(st, "smt.bit-vector.internalize.calls") == 2);
+    ENSURE(!has_stat(st, "smt.bit-vector.internalize.propagations"));
+    std::ostringstream out;
+    p.display_folded(out);
+    std::string folded = out.str();
+    std::cout << folded;
+    ENSURE(folded.find("smt;arithmetic.propagate ") != std::string::npos);
+    ENSURE(folded.find("smt;arithmetic.propagate;bit-vector.internalize ") != std::string::npos);
+
+    // every theory of a profiled context has a name.
+    smt_params params;
+    params.m_profile = true;
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    pb_util pb(m);
+    smt::context ctx(m, params);
+    expr_ref x(m.mk_const(symbol("x"), a.mk_int()), m);
+    expr_ref_vector bs(m);
+    for (unsigned i = 0; i < 3; ++i)
+        bs.push_back(m.mk_const(symbol((std::string("b") + std::to_string(i)).c_str()), m.mk_bool_sort()));
+    ctx.assert_expr(pb.mk_at_most_k(bs, 1));
+    ctx.assert_expr(m.mk_or(bs));
+    ctx.assert_expr(m.mk_implies(bs.get(0), a.mk_gt(x, a.mk_int(2))));
+    ctx.assert_expr(m.mk_implies(bs.get(1), a.mk_lt(x, a.mk_int(0))));
+    ctx.assert_expr(m.mk_not(bs.get(2)));
+    ENSURE(ctx.check() == l_true);
+    for (smt::theory* th : ctx.theories())
+        ENSURE(strcmp(th->get_name(), "unknown") != 0);
+    statistics cst;
+    ctx.collect_statistics(cst);
+    ENSURE(get_uint_stat(cst, "smt.arithmetic.internalize.calls") > 0);
+    ENSURE(get_uint_stat(cst, "smt.pb.propagate.calls") > 0);
+    ENSURE(get_uint_stat(cst, "smt.char.final_check.calls") > 0);
+    for (unsigned i = 0; i < cst.size(); ++i)
+        ENSURE(!strstr(cst.get_key(i), "unknown"));
+}
 
 void tst_smt_context()
 {
+    tst_snapshot();
+    tst_tiered_lemma_gc();
+    tst_parallel_ematching();
+    tst_parallel_lemma_sharing();
+    tst_profiler();
+
     smt_params params;
 
     ast_manager m;
@@ -1,8 +1,71 @@
 #include "ast/reg_decl_plugins.h"
 #include "solver/solver_pool.h"
 #include "smt/smt_solver.h"
+#include "model/model.h"
+
+static unsigned get_uint_stat(statistics const& st, char const* key) {
+    for (unsigned i = 0; i < st.size(); ++i)
+        if (st.is_uint(i) && strcmp(st.get_key(i), key) == 0)
+            return st.get_uint_value(i);
+    return 0;
+}
+
+// A refreshed base solver inherits phases, but not lemmas that depend on
+// assertions of pool solvers or on scopes that were popped.
+static void tst_refresh() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    params_ref p;
+    ref<solver> base = mk_smt_solver(m, p, symbol::null);
+
+    expr_ref c(m.mk_const(symbol("c"), m.mk_bool_sort()), m);
+    expr_ref d(m.mk_const(symbol("d"), m.mk_bool_sort()), m);
+    expr_ref e(m.mk_const(symbol("e"), m.mk_bool_sort()), m);
+    expr_ref f(m.mk_const(symbol("f"), m.mk_bool_sort()), m);
+    base->assert_expr(m.mk_or(c, d));
+    base->assert_expr(m.mk_or(e, f));
+
+    solver_pool pool(base.get(), 1);
+    ref<solver> s1 = pool.mk_solver();
+    ref<solver> s2 = pool.mk_solver();
+
+    // d is derived from an assertion guarded by the predicate of s1.
+    s1->assert_expr(m.mk_not(c));
+    ENSURE(s1->check_sat(0, nullptr) == l_true);
+    // d is derived in a scope of the base solver that is popped.
+    s2->push();
+    s2->push();
+    s2->assert_expr(m.mk_not(c));
+    s2->assert_expr(e);
+    ENSURE(s2->check_sat(0, nullptr) == l_true);
+    s2->pop(2);
+    s2->assert_expr(e);
+    ENSURE(s2->check_sat(0, nullptr) == l_true);
+
+    pool.reset_solver(s1.get());
+    statistics st;
+    pool.collect_statistics(st);
+    ENSURE(get_uint_stat(st, "pool_solver.inherited") == 1);
+
+    // the phase of e is inherited from the retired base solver.
+    model_ref mdl;
+    ENSURE(s1->check_sat(0, nullptr) == l_true);
+    s1->get_model(mdl);
+    ENSURE(mdl->is_true(e));
+
+    s1->push();
+    s1->push();
+    s1->assert_expr(m.mk_not(d));
+    ENSURE(s1->check_sat(0, nullptr) == l_true);
+    s1->pop(2);
+    s1->assert_expr(m.mk_not(d));
+    ENSURE(s1->check_sat(0, nullptr) == l_true);
+    ENSURE(s2->check_sat(0, nullptr) == l_true);
+}
 
 void tst_solver_pool() {
+    tst_refresh();
+
     ast_manager m;
     reg_decl_plugins(m);
     params_ref p;
@@ -454,6 +454,28 @@ public:
         return nullptr;
     }
 
+    /**
+       \brief Version of find_core that compares elements using eq instead of
+       the equality predicate of the table. eq must be compatible with the hash function.
+    */
+    template<typename Eq>
+    T * find_core(T const & d, Eq const & eq) const {
+        unsigned mask = m_slots - 1;
+        unsigned h    = get_hash(d);
+        unsigned idx  = h & mask;
+        cell * c      = m_table + idx;
+        if (c->is_free())
+            return nullptr;
+        do { 
+            if (eq(c->m_data, d)) {
+                return &(c->m_data);
+            }
+            c = c->m_next;
+        }
+        while (c != nullptr);
+        return nullptr;
+    }
+
     bool find(T const & d, T & r) {
         unsigned mask = m_slots - 1;
         unsigned h    = get_hash(d);
@@ -0,0 +1,78 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    decimal_scan.h
+
+Abstract:
+
+    Scan unsigned decimal numbers from input held in memory.
+
+    Digits are decoded eight at a time: the next eight characters
+    are loaded into a 64-bit word, the prefix of digits is located
+    with bit-parallel tests and converted using three multiplications.
+
+Revision History:
+
+--*/
+#pragma once
+
+#include <cstdint>
+#include "util/bit_util.h"
+
+namespace decimal_scan {
+
+    inline bool is_digit(char c) { return '0' <= c && c <= '9'; }
+
+    inline uint64_t load8(char const* p) {
+        uint64_t w = 0;
+        for (unsigned i = 8; i-- > 0; )
+            w = (w << 8) | static_cast<unsigned char>(p[i]);
+        return w;
+    }
+
+    // number of leading characters in w that are digits.
+    inline unsigned num_digits8(uint64_t w) {
+        uint64_t nd = ((w & 0xF0F0F0F0F0F0F0F0ull) ^ 0x3030303030303030ull) |
+            (((w & 0x0F0F0F0F0F0F0F0Full) + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull);
+        nd = (((nd & 0x7F7F7F7F7F7F7F7Full) + 0x7F7F7F7F7F7F7F7Full) | nd) & 0x8080808080808080ull;
+        if (nd == 0)
+            return 8;
+        unsigned lo = static_cast<unsigned>(nd);
+        return lo != 0 ? ntz_core(lo) / 8 : 4 + ntz_core(static_cast<unsigned>(nd >> 32)) / 8;
+    }
+
+    // value of the first n characters of w, all of which are digits.
+    inline unsigned decode8(uint64_t w, unsigned n) {
+        w = (w & 0x0F0F0F0F0F0F0F0Full) << (8 * (8 - n));
+        w = (w * 10) + (w >> 8);
+        w = (((w & 0x000000FF000000FFull) * 0x000F424000000064ull) +
+             (((w >> 16) & 0x000000FF000000FFull) * 0x0000271000000001ull)) >> 32;
+        return static_cast<unsigned>(w);
+    }
+
+    /**
+       \brief read the digits starting at curr and advance curr past them.
+       Return 0 if curr does not point to a digit.
+    */
+    inline unsigned scan(char const*& curr, char const* end) {
+        unsigned val = 0;
+        if (end - curr >= 8) {
+            uint64_t w = load8(curr);
+            unsigned n = num_digits8(w);
+            if (n == 0)
+                return 0;
+            val = decode8(w, n);
+            curr += n;
+            if (n < 8)
+                return val;
+        }
+        while (curr < end && is_digit(*curr)) {
+            val = val * 10 + (*curr - '0');
+            ++curr;
+        }
+        return val;
+    }
+
+};
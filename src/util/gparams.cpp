@@ -175,7 +175,9 @@ public:
     }
 
     ~imp() {
-        reset();
+        for (auto & kv : m_module_params) {
+            dealloc(kv.m_value);
+        }
         for (auto & kv : m_module_param_descrs) {
             dealloc(kv.m_value);
         }
@@ -184,11 +186,11 @@ public:
     void reset() {
         lock_guard lock(*gparams_mux);
         m_params.reset();
+        // The names of registered modules are also allocated in m_region,
+        // so the module entries are kept and only their values are reset.
         for (auto & kv : m_module_params) {
-            dealloc(kv.m_value);
+            *kv.m_value = params_ref();
         }
-        m_module_params.reset();        
-        m_region.reset();
     }
 
     // -----------------------------------------------
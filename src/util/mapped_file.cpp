@@ -0,0 +1,67 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    mapped_file.cpp
+
+Abstract:
+
+    Read-only view of the contents of a file.
+
+Revision History:
+
+--*/
+#include <fstream>
+#include <sstream>
+#include "util/mapped_file.h"
+#ifndef _WINDOWS
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+void mapped_file::reset() {
+#ifndef _WINDOWS
+    if (m_mapped)
+        munmap(const_cast<char*>(m_data), m_size);
+#endif
+    m_data = nullptr;
+    m_size = 0;
+    m_mapped = false;
+    m_contents.clear();
+}
+
+bool mapped_file::open(char const* file_name) {
+    reset();
+#ifndef _WINDOWS
+    int fd = ::open(file_name, O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        void* p = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED) {
+#ifdef MADV_SEQUENTIAL
+            madvise(p, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+#endif
+            m_data = static_cast<char const*>(p);
+            m_size = static_cast<size_t>(st.st_size);
+            m_mapped = true;
+        }
+    }
+    ::close(fd);
+    if (m_mapped)
+        return true;
+#endif
+    std::ifstream in(file_name, std::ios::binary);
+    if (in.bad() || in.fail())
+        return false;
+    std::ostringstream buffer;
+    buffer << in.rdbuf();
+    m_contents = buffer.str();
+    m_data = m_contents.data();
+    m_size = m_contents.size();
+    return true;
+}
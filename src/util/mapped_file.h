@@ -0,0 +1,48 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    mapped_file.h
+
+Abstract:
+
+    Read-only view of the contents of a file.
+
+    The file is memory mapped where this is supported.
+    Otherwise, or if mapping fails, the contents are read
+    into memory.
+
+Revision History:
+
+--*/
+#pragma once
+
+#include <string>
+
+class mapped_file {
+    char const* m_data;
+    size_t      m_size;
+    bool        m_mapped;
+    std::string m_contents;
+
+    mapped_file(mapped_file const&) = delete;
+    mapped_file& operator=(mapped_file const&) = delete;
+
+    void reset();
+
+public:
+    mapped_file(): m_data(nullptr), m_size(0), m_mapped(false) {}
+
+    ~mapped_file() { reset(); }
+
+    /**
+       \brief open file_name. Return false if the file cannot be read.
+    */
+    bool open(char const* file_name);
+
+    char const* begin() const { return m_data; }
+    char const* end() const { return m_data + m_size; }
+    size_t size() const { return m_size; }
+    bool is_mapped() const { return m_mapped; }
+};
@@ -53,6 +53,8 @@ public:
     bool suspended() const { return m_suspend;  }
     inline bool not_canceled() const { return (m_cancel == 0 && m_count <= m_limit) || m_suspend; }
     inline bool is_canceled() const { return !not_canceled(); }
+    // the limit is not exceeded by offset additional increments.
+    inline bool not_canceled(uint64_t offset) const { return (m_cancel == 0 && m_count + offset <= m_limit) || m_suspend; }
     char const* get_cancel_msg() const;
     void cancel();
     void reset_cancel();